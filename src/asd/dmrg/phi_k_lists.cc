@@ -39,7 +39,7 @@ PhiKLists::PhiKLists(shared_ptr<const CIStringSet<RASString>> source_stringspace
       vector<PhiK> iphilist;
       for (size_t ia = 0; ia < source_space->size(); ++ia) {
         const bitset<nbit__> sbit = source_stringspace->strings(ia + source_space->offset());
-        const bitset<nbit__> tbit = sbit ^ bitset<nbit__>(1 << k);
+        const bitset<nbit__> tbit = bitset<nbit__>(sbit).flip(k);
 
         // counting nelea dictates whether the target bit belongs to the right set of determinants
         if (tbit.count() == nele_target && target_stringspace->allowed(tbit)) {
@@ -25,6 +25,7 @@
 #ifndef __SRC_CIUTIL_BITUTIL_H
 #define __SRC_CIUTIL_BITUTIL_H
 
+#include <array>
 #include <bitset>
 #include <string>
 #include <vector>
@@ -59,9 +60,37 @@ namespace bagel {
       return print_bit(bit, 0, max);
     }
 
+    // 64-bit words of a string; nbit__ == 64 is a single word and needs no shifts
+    template<size_t N>
+    std::array<unsigned long long, N/64> bit_to_words(const std::bitset<N>& bit) {
+      static_assert(N % 64 == 0, "bit_to_words assumes whole words");
+      std::array<unsigned long long, N/64> out;
+      if (N == 64) {
+        out[0] = bit.to_ullong();
+      } else {
+        const std::bitset<N> word(~0ull);
+        for (size_t i = 0; i != N/64; ++i)
+          out[i] = ((bit >> (64*i)) & word).to_ullong();
+      }
+      return out;
+    }
+
+    // calls f(i) for every set bit i in [start, fence) in increasing order
+    template<size_t N, class F>
+    void for_each_bit(const std::bitset<N>& bit, const int start, const int fence, F f) {
+      const std::array<unsigned long long, N/64> words = bit_to_words(bit);
+      for (int w = start/64; w < (fence+63)/64; ++w) {
+        unsigned long long x = words[w];
+        if (start > 64*w) x &= ~0ull << (start - 64*w);
+        if (fence < 64*(w+1)) x &= (1ull << (fence - 64*w)) - 1ull;
+        for ( ; x; x &= x - 1ull)
+          f(64*w + __builtin_ctzll(x));
+      }
+    }
+
     std::vector<int> bit_to_numbers(std::bitset<nbit__> bit) {
       std::vector<int> out;
-      for (int i = 0; i != nbit__; ++i) if (bit[i]) out.push_back(i);
+      for_each_bit(bit, 0, nbit__, [&out](const int i) { out.push_back(i); });
       return out;
     }
 
@@ -71,18 +100,25 @@ namespace bagel {
       return out;
     }
 
-    int sign(std::bitset<nbit__> bit, int i, int j) {
-      // masking irrelevant bits
+    // parity of the number of electrons between orbitals i and j (exclusive); i = -1 counts from the first orbital
+    template<size_t N>
+    int sign(const std::bitset<N>& bit, int i, int j) {
       int min, max;
       std::tie(min,max) = std::minmax(i,j);
-      bit &= ((~std::bitset<nbit__>(0ull)) << min+1);
-      bit &= ((~std::bitset<nbit__>(0ull)) >> (nbit__ - max));
-      return 1 - ((bit.count() & 1) << 1);
+      if (N == 64) {
+        const unsigned long long mask = ((1ull << max) - 1ull) & (~0ull << (min+1));
+        return 1 - ((__builtin_popcountll(bit.to_ullong() & mask) & 1) << 1);
+      }
+      // shifting the irrelevant bits out
+      return 1 - ((((bit >> (min+1)) << (N - max + min + 1)).count() & 1) << 1);
     }
 
-    int sign(std::bitset<nbit__> bit, int i) {
-      bit &= ((~std::bitset<nbit__>(0ull)) >> (nbit__ - i));
-      return 1 - ((bit.count() & 1 ) << 1);
+    // parity of the number of electrons in orbitals below i
+    template<size_t N>
+    int sign(const std::bitset<N>& bit, int i) {
+      if (N == 64)
+        return 1 - ((__builtin_popcountll(bit.to_ullong() & (i < 64 ? (1ull << i) - 1ull : ~0ull)) & 1) << 1);
+      return 1 - (((bit << (N - i)).count() & 1) << 1);
     }
 
   }
@@ -33,6 +33,7 @@
 #include <src/util/parallel/mpi_interface.h>
 #include <src/util/serialization.h>
 #include <src/ci/ciutil/cistringmap.h>
+#include <src/ci/ciutil/bitutil.h>
 
 namespace bagel {
 
@@ -65,8 +66,7 @@ class CIGraph {
       size_t out = 0;
 
       int k = 0;
-      for (int i = start; i < fence; ++i)
-        if (abit[i]) out += weight(i-start,k++);
+      for_each_bit(abit, start, fence, [&](const int i) { out += weight(i-start,k++); });
       return out;
     }
 };
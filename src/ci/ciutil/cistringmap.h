@@ -74,6 +74,9 @@ class StringMap {
 
     const std::vector<DetMap>& data(const size_t i) const { assert(i < data_.size()); return data_[i]; }
 
+    std::vector<std::vector<DetMap>>::const_iterator begin() const { return data_.cbegin(); }
+    std::vector<std::vector<DetMap>>::const_iterator end() const { return data_.cend(); }
+
     void insert(const std::vector<std::vector<DetMap>>& inp) {
       assert(data_.size() == inp.size());
       auto j = inp.begin();
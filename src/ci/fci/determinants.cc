@@ -83,6 +83,34 @@ Determinants::Determinants(shared_ptr<const FCIStringSet> ast, shared_ptr<const
 }
 
 
+shared_ptr<const StringMap> Determinants::construct_phiup_int(const int spin, const int nexc) const {
+  const int nele = (spin == 0 ? nelea() : neleb()) - nexc;
+  if (nele < 0)
+    return make_shared<StringMap>(0);
+
+  const FCIString intstring(nele, norb());
+  auto out = make_shared<StringMap>(intstring.size());
+  for (size_t k = 0; k != intstring.size(); ++k) {
+    const bitset<nbit__>& kbit = intstring.strings(k);
+    for (int i = 0, ij = 0; i != norb(); ++i) {
+      if (nexc == 1) {
+        if (kbit[i]) continue;
+        bitset<nbit__> ibit = kbit; ibit.set(i);
+        (*out)[k].emplace_back(spin == 0 ? lexical<0>(ibit) : lexical<1>(ibit), sign(ibit, -1, i), k, i);
+      } else {
+        for (int j = 0; j < i; ++j, ++ij) {
+          if (kbit[i] || kbit[j]) continue;
+          bitset<nbit__> ijbit = kbit; ijbit.set(i); ijbit.set(j);
+          (*out)[k].emplace_back(spin == 0 ? lexical<0>(ijbit) : lexical<1>(ijbit), sign(ijbit, i, j), k, ij);
+        }
+      }
+    }
+    (*out)[k].shrink_to_fit();
+  }
+  return out;
+}
+
+
 pair<vector<tuple<int, int, int>>, double> Determinants::spin_adapt(const int spin, bitset<nbit__> alpha, bitset<nbit__> beta) const {
   if (spin < 0)
     swap(alpha, beta);
@@ -105,7 +133,7 @@ pair<vector<tuple<int, int, int>>, double> Determinants::spin_adapt(const int sp
   }
   bitset<nbit__> salpha = numbers_to_bit(salpha_array);
   bitset<nbit__> ualpha = numbers_to_bit(ualpha_array);
-  bitset<nbit__> common_plus_alpha(common.to_ulong() + ualpha.to_ulong());
+  bitset<nbit__> common_plus_alpha = common | ualpha;
 
   // number of unpaired alpha orbitals (minus Ms)
   const int nalpha = salpha.count();
@@ -26,6 +26,7 @@
 #ifndef __SRC_FCI_DETERMINANTS_H
 #define __SRC_FCI_DETERMINANTS_H
 
+#include <mutex>
 #include <src/ci/ciutil/determinants_base.h>
 
 namespace bagel {
@@ -39,6 +40,12 @@ class Determinants : public Determinants_base<FCIString>,
     std::weak_ptr<Determinants> remalpha_;
     std::weak_ptr<Determinants> rembeta_;
 
+    // i^dagger (nexc = 1) and i^dagger j^dagger with i > j (nexc = 2) acting on strings with nexc fewer electrons,
+    // grouped by the intermediate string; constructed on first use and indexed by spin*2 + nexc-1
+    mutable std::array<std::shared_ptr<const StringMap>, 4> phiup_int_;
+    mutable std::mutex phiup_int_mutex_;
+    std::shared_ptr<const StringMap> construct_phiup_int(const int spin, const int nexc) const;
+
   private:
     friend class boost::serialization::access;
     template<class Archive>
@@ -83,6 +90,17 @@ class Determinants : public Determinants_base<FCIString>,
     template<int Spin>
     size_t lexical(const std::bitset<nbit__>& bit) const { return lexical_zero<Spin>(bit); }
 
+    // DetMap(target, sign, intermediate, orbital or packed pair index) for each intermediate string
+    template<int spin>
+    std::shared_ptr<const StringMap> phiup_int(const int nexc) const {
+      assert(nexc == 1 || nexc == 2);
+      std::lock_guard<std::mutex> lock(phiup_int_mutex_);
+      std::shared_ptr<const StringMap>& out = phiup_int_[spin*2 + nexc-1];
+      if (!out)
+        out = construct_phiup_int(spin, nexc);
+      return out;
+    }
+
     template<int spin>
     void link(std::shared_ptr<Determinants> odet) { bagel::link<spin, FCIString>(shared_from_this(), odet); }
 
@@ -22,10 +22,8 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-#include <src/util/combination.hpp>
-#include <src/util/math/comb.h>
 #include <src/ci/fci/distfci_ab.h>
-#include <src/ci/fci/distfci_bb.h>
+#include <src/ci/fci/hztasks.h>
 #include <src/ci/fci/dist_form_sigma.h>
 
 using namespace std;
@@ -52,7 +50,7 @@ vector<shared_ptr<DistCivec>> FormSigmaDistFCI::operator()(const vector<shared_p
 
     shared_ptr<DistCivec> ctrans = cc->transpose();
     shared_ptr<DistCivec> strans = ctrans->clone();
-    sigma_aa(ctrans, strans, jop, cc->det()->remalpha()->rembeta());
+    sigma_aa(ctrans, strans, jop, cc->det());
     fcitime.tick_print("alpha-alpha");
 
     sigma_bb(cc, sigma, jop);
@@ -111,23 +109,21 @@ void FormSigmaDistFCI::sigma_ab(shared_ptr<const DistCivec> cc, shared_ptr<DistC
 
 
 
-void FormSigmaDistFCI::sigma_aa(shared_ptr<const DistCivec> ctrans, shared_ptr<DistCivec> strans, shared_ptr<const MOFile> jop, shared_ptr<const Determinants> int_det) const {
-  shared_ptr<const Determinants> trans_det = ctrans->det();
-  shared_ptr<const Determinants> int_tra = int_det->transpose();
-  sigma_bb(ctrans, strans, jop, ctrans->det(), int_tra);
+// alpha strings of det are the beta strings of the transposed vectors
+void FormSigmaDistFCI::sigma_aa(shared_ptr<const DistCivec> ctrans, shared_ptr<DistCivec> strans, shared_ptr<const MOFile> jop, shared_ptr<const Determinants> det) const {
+  sigma_bb(ctrans, strans, jop, det->phiup_int<0>(1), det->phiup_int<0>(2));
 }
 
 
 void FormSigmaDistFCI::sigma_bb(shared_ptr<const DistCivec> cc, shared_ptr<DistCivec> sigma, shared_ptr<const MOFile> jop) const {
   const shared_ptr<const Determinants> base_det = cc->det();
-  const shared_ptr<const Determinants> int_det = base_det->remalpha()->rembeta(); // only for n-1 beta strings...
-  sigma_bb(cc, sigma, jop, base_det, int_det);
+  sigma_bb(cc, sigma, jop, base_det->phiup_int<1>(1), base_det->phiup_int<1>(2));
 }
 
 
 // beta-beta block has no communication (and should be cheap)
 void FormSigmaDistFCI::sigma_bb(shared_ptr<const DistCivec> cc, shared_ptr<DistCivec> sigma, shared_ptr<const MOFile> jop,
-                                shared_ptr<const Determinants> base_det, shared_ptr<const Determinants> int_det) const {
+                                shared_ptr<const StringMap> phi1, shared_ptr<const StringMap> phi2) const {
 
   const int norb = cc->det()->norb();
   const size_t lb = sigma->lenb();
@@ -154,29 +150,16 @@ void FormSigmaDistFCI::sigma_bb(shared_ptr<const DistCivec> cc, shared_ptr<DistC
     }
   }
 
-  const size_t neleb = base_det->neleb();
-
-  const static Comb comb;
-  const size_t lengb = comb(norb, neleb-2);
-  vector<bitset<nbit__>> intb(lengb, bitset<nbit__>(0));
-  vector<int> data(norb);
-  iota(data.begin(), data.end(), 0);
-  auto sa = intb.begin();
-  do {
-    for (int i=0; i < neleb-2; ++i) sa->set(data[i]);
-    ++sa;
-  } while (boost::next_combination(data.begin(), data.begin()+neleb-2, data.end()));
-
   vector<mutex> localmutex(lb);
-  // loop over intermediate string
-  TaskQueue<DistBBTask> tasks(intb.size());
+  // loop over intermediate strings
+  TaskQueue<HZTaskAAInt> tasks(distance(phi1->begin(), phi1->end()) + distance(phi2->begin(), phi2->end()));
 
   // two electron part
-  for (auto& b : intb)
-    tasks.emplace_back(la, source.get(), target.get(), hamil2.get(), base_det, b, &localmutex);
+  for (auto& b : *phi2)
+    tasks.emplace_back(b, la, source.get(), target.get(), hamil2.get(), npack, &localmutex);
   // one electron part
-  for (auto& b : int_det->string_bits_b())
-    tasks.emplace_back(la, source.get(), target.get(), hamil1.get(), base_det, b, &localmutex);
+  for (auto& b : *phi1)
+    tasks.emplace_back(b, la, source.get(), target.get(), hamil1.get(), norb, &localmutex);
 
   tasks.compute();
 
@@ -90,23 +90,31 @@ void HarrisonZarrabian::sigma_aa(shared_ptr<const Civec> cc, shared_ptr<Civec> s
   shared_ptr<const Determinants> det = cc->det();
   const int lb = cc->lenb();
 
-  auto h1 = make_shared<Matrix>(norb_, norb_);
-  for (int i = 0, ij = 0; i < norb_; ++i) {
+  // one-electron Hamiltonian and antisymmetrized two-electron integrals over pairs i > j
+  const size_t npack = norb_*(norb_-1)/2;
+  unique_ptr<double[]> hamil1(new double[norb_*norb_]);
+  unique_ptr<double[]> hamil2(new double[npack*npack]);
+  for (int i = 0, ij = 0, ijkl = 0; i != norb_; ++i) {
     for (int j = 0; j <= i; ++j, ++ij) {
-      h1->element(i, j) = h1->element(j, i) = jop->mo1e(ij);
+      hamil1[j+norb_*i] = hamil1[i+norb_*j] = jop->mo1e(ij);
+      if (i == j) continue;
+      for (int k = 0; k != norb_; ++k)
+        for (int l = 0; l < k; ++l, ++ijkl)
+          hamil2[ijkl] = jop->mo2e_hz(l,k,j,i) - jop->mo2e_hz(k,l,j,i);
     }
   }
 
-  auto h2 = make_shared<Matrix>(*jop->mo2e());
-  sort_indices<1,0,2,3,1,1,-1,1>(jop->mo2e()->data(), h2->data(), norb_, norb_, norb_, norb_);
+  // excitation lists are grouped by intermediate strings so that each task is a dense GEMM
+  shared_ptr<const StringMap> phi1 = det->phiup_int<0>(1);
+  shared_ptr<const StringMap> phi2 = det->phiup_int<0>(2);
 
-  TaskQueue<HZTaskAA<double>> tasks(det->lena());
+  vector<mutex> localmutex(det->lena());
+  TaskQueue<HZTaskAAInt> tasks(distance(phi1->begin(), phi1->end()) + distance(phi2->begin(), phi2->end()));
 
-  double* target = sigma->data();
-  for (auto& a : det->string_bits_a()) {
-    tasks.emplace_back(cc, a, target, h1->data(), h2->data());
-    target += lb;
-  }
+  for (auto& k : *phi2)
+    tasks.emplace_back(k, lb, cc->data(), sigma->data(), hamil2.get(), npack, &localmutex);
+  for (auto& k : *phi1)
+    tasks.emplace_back(k, lb, cc->data(), sigma->data(), hamil1.get(), norb_, &localmutex);
 
   tasks.compute();
 }
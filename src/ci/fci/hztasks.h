@@ -25,6 +25,7 @@
 #ifndef __BAGEL_FCI_HZTASKS_H
 #define __BAGEL_FCI_HZTASKS_H
 
+#include <mutex>
 #include <src/util/f77.h>
 
 namespace bagel {
@@ -92,6 +93,51 @@ class HZTaskAA {
 };
 
 
+// Same-spin contributions through one intermediate string K with one or two fewer electrons:
+//   D(:, p) = sign C(:, K+p),  E = D H(p, q),  sigma(:, K+q) += sign E(:, q)
+// where p and q run over the orbitals (pairs) unoccupied in K. Rows of the source and target are contiguous.
+class HZTaskAAInt {
+  protected:
+    const std::vector<DetMap>& phi_;
+    const size_t lrow_;
+    const double* const source_;
+    double* const target_;
+    const double* const hamil_;
+    const size_t nind_;
+    std::vector<std::mutex>* const mutex_;
+
+  public:
+    HZTaskAAInt(const std::vector<DetMap>& phi, const size_t lrow, const double* const source, double* const target,
+                const double* const hamil, const size_t nind, std::vector<std::mutex>* mutex)
+      : phi_(phi), lrow_(lrow), source_(source), target_(target), hamil_(hamil), nind_(nind), mutex_(mutex) {}
+
+    void compute() {
+      const size_t n = phi_.size();
+      if (n == 0) return;
+
+      std::unique_ptr<double[]> h(new double[n*n]);
+      for (size_t q = 0; q != n; ++q)
+        for (size_t p = 0; p != n; ++p)
+          h[p+n*q] = hamil_[phi_[p].ij + nind_*phi_[q].ij];
+
+      std::unique_ptr<double[]> ints(new double[lrow_*n]);
+      std::unique_ptr<double[]> ints2(new double[lrow_*n]);
+      for (size_t p = 0; p != n; ++p) {
+        const double sign = static_cast<double>(phi_[p].sign);
+        const double* const source = source_ + lrow_*phi_[p].target;
+        std::transform(source, source+lrow_, ints.get()+lrow_*p, [&sign](const double a) { return sign*a; });
+      }
+
+      dgemm_("N", "N", lrow_, n, n, 1.0, ints.get(), lrow_, h.get(), n, 0.0, ints2.get(), lrow_);
+
+      for (size_t q = 0; q != n; ++q) {
+        std::lock_guard<std::mutex> lock((*mutex_)[phi_[q].target]);
+        blas::ax_plus_y_n(static_cast<double>(phi_[q].sign), ints2.get()+lrow_*q, lrow_, target_+lrow_*phi_[q].target);
+      }
+    }
+};
+
+
 template<typename DataType>
 class HZTaskAB1 {
   protected:
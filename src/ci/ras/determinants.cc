@@ -134,7 +134,7 @@ pair<vector<tuple<bitset<nbit__>, bitset<nbit__>, int>>, double> RASDeterminants
   }
   bitset<nbit__> salpha = numbers_to_bit(salpha_array);
   bitset<nbit__> ualpha = numbers_to_bit(ualpha_array);
-  bitset<nbit__> common_plus_alpha(common.to_ulong() + ualpha.to_ulong());
+  bitset<nbit__> common_plus_alpha = common | ualpha;
 
   // number of unpaired alpha orbitals (minus Ms)
   const int nalpha = salpha.count();
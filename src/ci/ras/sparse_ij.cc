@@ -49,10 +49,10 @@ Sparse_IJ::Sparse_IJ(shared_ptr<const CIStringSet<RASString>> source_stringspace
       const bitset<nbit__> tbit = target_space->strings(itar);
       for (int i = 0; i < norb; ++i) {
         if (!tbit[i]) continue;
-        const bitset<nbit__> tmpbit = tbit ^ bitset<nbit__>(1 << i);
+        const bitset<nbit__> tmpbit = bitset<nbit__>(tbit).reset(i);
         for (int j = 0; j < norb; ++j) {
           if (tmpbit[j]) continue;
-          const bitset<nbit__> sbit = tmpbit ^ bitset<nbit__>(1 << j);
+          const bitset<nbit__> sbit = bitset<nbit__>(tmpbit).set(j);
           int isource_space = 0;
           for (auto& source_space : *source_stringspace) {
             if (source_space->contains(sbit)) {
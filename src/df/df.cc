@@ -34,6 +34,7 @@ using namespace btas;
 
 
 shared_ptr<DFDist> DFDist::copy() const {
+  if (sparse() || single()) throw logic_error("DFDist::copy is not implemented for the sparse or single-precision storage");
   auto out = make_shared<DFDist>(df_);
   for (auto& i : block_)
     out->add_block(i->copy());
@@ -42,6 +43,7 @@ shared_ptr<DFDist> DFDist::copy() const {
 
 
 shared_ptr<DFDist> DFDist::clone() const {
+  if (sparse() || single()) throw logic_error("DFDist::clone is not implemented for the sparse or single-precision storage");
   auto out = make_shared<DFDist>(df_);
   for (auto& i : block_)
     out->add_block(i->clone());
@@ -128,9 +130,11 @@ shared_ptr<const StaticDist> DFDist::make_table(const size_t astart) {
 
 pair<const double*, shared_ptr<RysInt>> DFDist::compute_batch(array<shared_ptr<const Shell>,4>& input) {
 #ifdef LIBINT_INTERFACE
+  if (omega_ != 0.0)
+    throw runtime_error("attenuated integrals are not available with the libint interface");
   shared_ptr<RysInt> eribatch = make_shared<Libint>(input);
 #else
-  shared_ptr<RysInt> eribatch = make_shared<ERIBatch>(input, 2.0);
+  shared_ptr<RysInt> eribatch = make_shared<ERIBatch>(input, 2.0, omega_);
 #endif
   eribatch->compute();
   return {eribatch->data(), eribatch};
@@ -138,8 +142,13 @@ pair<const double*, shared_ptr<RysInt>> DFDist::compute_batch(array<shared_ptr<c
 
 
 shared_ptr<DFHalfDist> DFDist::compute_half_transform(const MatView c) const {
+  Profile prof("DF half transform");
   const int nocc = c.extent(1);
   auto out = make_shared<DFHalfDist>(df_ ? df_ : shared_from_this(), nocc);
+  if (sparse_block_)
+    out->add_block(sparse_block_->transform_second(c));
+  if (single_block_)
+    out->add_block(single_block_->transform_second(c));
   for (auto& i : block_)
     out->add_block(i->transform_second(c));
   return out;
@@ -149,16 +158,98 @@ shared_ptr<DFHalfDist> DFDist::compute_half_transform(const MatView c) const {
 shared_ptr<DFHalfDist> DFDist::compute_half_transform_swap(const MatView c) const {
   const int nocc = c.extent(1);
   auto out = make_shared<DFHalfDist>(df_ ? df_ : shared_from_this(), nocc);
+  // the sparse and single-precision storage are symmetric in the two AO indices
+  if (sparse_block_)
+    out->add_block(sparse_block_->transform_second(c));
+  if (single_block_)
+    out->add_block(single_block_->transform_second(c));
   for (auto& i : block_)
     out->add_block(i->transform_third(c)->swap());
   return out;
 }
 
 
+shared_ptr<DFHalfDist> DFDist::compute_half_transform_screened(const MatView c, const vector<int>& bounds, const double thresh) const {
+  Profile prof("DF half transform");
+  // the sparse storage is already screened at the shell-pair level; the single-precision one uses a single SGEMM
+  if (sparse_block_ || single_block_)
+    return compute_half_transform(c);
+  const int nocc = c.extent(1);
+  auto out = make_shared<DFHalfDist>(df_ ? df_ : shared_from_this(), nocc);
+  if (bounds != screen_bounds_ || screen_intmax_.size() != block_.size()) {
+    screen_intmax_.clear();
+    for (auto& i : block_)
+      screen_intmax_.push_back(i->block_max(bounds));
+    screen_bounds_ = bounds;
+  }
+  for (int i = 0; i != block_.size(); ++i)
+    out->add_block(block_[i]->transform_second_screened(c, bounds, screen_intmax_[i], thresh));
+  return out;
+}
+
+
+void DFDist::convert_to_single() {
+  if (sparse_block_ || block_.size() != 1) throw logic_error("DFDist::convert_to_single requires one dense block");
+  single_block_ = make_shared<DFSingleBlock>(block_[0]);
+  block_.clear();
+}
+
+
+shared_ptr<Matrix> DFDist::form_2index(shared_ptr<const ParallelDF> o, const double a, const bool swap) const {
+  if (!sparse_block_ && !single_block_)
+    return ParallelDF::form_2index(o, a, swap);
+  if (o->block().size() != 1) throw logic_error("DFDist::form_2index with the sparse or single-precision storage requires a dense partner");
+  shared_ptr<Matrix> out = sparse_block_ ? sparse_block_->form_2index(o->block(0), a) : single_block_->form_2index(o->block(0), a);
+  if (swap)
+    out = out->transpose();
+  if (!serial_)
+    out->allreduce();
+  return out;
+}
+
+
+shared_ptr<Matrix> DFDist::compute_Jop_from_cd(shared_ptr<const VectorB> tmp0) const {
+  shared_ptr<Matrix> out;
+  if (sparse_block_)
+    out = sparse_block_->form_mat(tmp0->slice(sparse_block_->astart(), sparse_block_->astart()+sparse_block_->asize()));
+  else if (single_block_)
+    out = single_block_->form_mat(tmp0->slice(single_block_->astart(), single_block_->astart()+single_block_->asize()));
+  else
+    return ParallelDF::compute_Jop_from_cd(tmp0);
+  if (!serial_)
+    out->allreduce();
+  return out;
+}
+
+
+shared_ptr<VectorB> DFDist::compute_cd(const shared_ptr<const Matrix> den, shared_ptr<const Matrix> dat2, const int number_of_j) const {
+  if (!sparse_block_ && !single_block_)
+    return ParallelDF::compute_cd(den, dat2, number_of_j);
+  if (!dat2 && !data2_) throw logic_error("DFDist::compute_cd was called without 2-index integrals");
+  if (!dat2) dat2 = data2_;
+
+  auto tmp0 = make_shared<VectorB>(naux_);
+  shared_ptr<VectorB> tmp = sparse_block_ ? sparse_block_->form_vec(den) : single_block_->form_vec(den);
+  const size_t astart = sparse_block_ ? sparse_block_->astart() : single_block_->astart();
+  copy_n(tmp->data(), tmp->size(), tmp0->data()+astart);
+  if (!serial_)
+    tmp0->allreduce();
+
+  if (number_of_j == 1)
+    *tmp0 = *dat2 * *tmp0;
+  else if (number_of_j == 2)
+    *tmp0 = *dat2 * (*dat2 * *tmp0);
+  else if (number_of_j != 0)
+    throw logic_error("wrong number of J in DFDist::compute_cd");
+  return tmp0;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
 shared_ptr<DFFullDist> DFHalfDist::compute_second_transform(const MatView c) const {
+  Profile prof("DF second transform");
   const int nocc = c.extent(1);
   auto out = make_shared<DFFullDist>(df_, nindex1_, nocc);
   for (auto& i : block_)
@@ -229,6 +320,15 @@ shared_ptr<DFHalfDist> DFHalfDist::apply_density(const shared_ptr<const Matrix>
 }
 
 
+shared_ptr<Matrix> DFHalfDist::form_2index_screened(const vector<int>& bounds, const double thresh, const double a) const {
+  if (block_.size() != 1) throw logic_error("so far assumes block_.size() == 1");
+  shared_ptr<Matrix> out = block_[0]->form_2index_screened(bounds, thresh, a);
+  if (!serial_)
+    out->allreduce();
+  return out;
+}
+
+
 shared_ptr<Matrix> DFHalfDist::compute_Kop_1occ(const shared_ptr<const Matrix> den, const double a) const {
   return apply_density(den)->form_2index(df_, a);
 }
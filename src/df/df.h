@@ -26,6 +26,7 @@
 #define __SRC_DF_DF_H
 
 #include <src/df/paralleldf.h>
+#include <src/df/dfsingleblock.h>
 #include <src/molecule/atom.h>
 
 namespace bagel {
@@ -37,6 +38,18 @@ class DFDist : public ParallelDF {
   friend class DFIntTask_OLD<DFDist>;
   friend class PDFIntTask_2index;
   protected:
+    // range-separation parameter when the integrals are of the erf(omega r)/r operator
+    double omega_ = 0.0;
+
+    // AO integrals of significant shell pairs only (block_ is then empty)
+    std::shared_ptr<DFSparseBlock> sparse_block_;
+    // AO integrals in single precision (block_ is then empty)
+    std::shared_ptr<DFSingleBlock> single_block_;
+
+    // block-wise maxima of the AO integrals used by the screened half transform; computed once per set of bounds
+    mutable std::vector<int> screen_bounds_;
+    mutable std::vector<std::vector<double>> screen_intmax_;
+
     std::pair<const double*, std::shared_ptr<RysInt>> compute_batch(std::array<std::shared_ptr<const Shell>,4>& input);
 
     std::shared_ptr<const StaticDist> make_table(const size_t nmax);
@@ -58,12 +71,34 @@ class DFDist : public ParallelDF {
     size_t nbasis0() const { return nindex2_; }
     size_t nbasis1() const { return nindex1_; }
     size_t naux() const { return naux_; }
+    double omega() const { return omega_; }
+    bool sparse() const { return !!sparse_block_; }
+    std::shared_ptr<const DFSparseBlock> sparse_block() const { return sparse_block_; }
+    bool single() const { return !!single_block_; }
+    std::shared_ptr<const DFSingleBlock> single_block() const { return single_block_; }
+    // true if the integrals are held in dense double-precision blocks (needed wherever block() is accessed)
+    bool dense() const { return !sparse_block_ && !single_block_; }
+    // replaces the dense integrals by their single-precision copy
+    void convert_to_single();
+    // number of elements of the local 3-index integrals in the dense layout
+    size_t local_size() const { return adist_now()->size(mpi__->rank()) * nindex1_ * nindex2_; }
+
+    // ParallelDF functions that are also available with the sparse and single-precision storage
+    std::shared_ptr<const StaticDist> adist_now() const override {
+      return sparse_block_ ? sparse_block_->adist_now() : (single_block_ ? single_block_->adist_now() : ParallelDF::adist_now());
+    }
+    std::shared_ptr<Matrix> form_2index(std::shared_ptr<const ParallelDF> o, const double a, const bool swap = false) const override;
+    std::shared_ptr<Matrix> compute_Jop_from_cd(std::shared_ptr<const VectorB> cd) const override;
+    std::shared_ptr<VectorB> compute_cd(const std::shared_ptr<const Matrix> den, std::shared_ptr<const Matrix> dat2 = nullptr, const int number_of_j = 2) const override;
 
     // compute half transforms; c is dimensioned by nbasis_;
     std::shared_ptr<DFHalfDist> compute_half_transform(const MatView c) const;
     template<typename T, class = typename std::enable_if<btas::is_boxtensor<T>::value>::type>
     std::shared_ptr<DFHalfDist> compute_half_transform(std::shared_ptr<T> c) const { return compute_half_transform(*c); }
 
+    // half transform with screening; blocks of basis functions are delimited by bounds (used for exchange builds)
+    std::shared_ptr<DFHalfDist> compute_half_transform_screened(const MatView c, const std::vector<int>& bounds, const double thresh) const;
+
     // compute half transform using the third index. You get DFHalfDist with gamma/i/s (i.e., index are reordered)
     std::shared_ptr<DFHalfDist> compute_half_transform_swap(const MatView c) const;
     template<typename T, class = typename std::enable_if<btas::is_boxtensor<T>::value>::type>
@@ -109,7 +144,7 @@ class DFDist_ints : public DFDist {
           if (TBatch::Nblocks() > 1 || j1 <= j2) {
             int j0 = 0;
             for (auto& i0 : ashell) {
-              tasks.emplace_back((std::array<std::shared_ptr<const Shell>,4>{{i3, i0, i1, i2}}), (std::array<int,3>{{j2, j1, j0}}), blk);
+              tasks.emplace_back((std::array<std::shared_ptr<const Shell>,4>{{i3, i0, i1, i2}}), (std::array<int,3>{{j2, j1, j0}}), blk, omega_);
               j0 += i0->nbasis();
             }
           }
@@ -123,10 +158,90 @@ class DFDist_ints : public DFDist {
 
     }
 
+    // the integrals are computed for a few batches of auxiliary shells at a time and stored in single precision,
+    // so that the double-precision copy never exists in full
+    void compute_3index_single(const std::vector<std::shared_ptr<const Shell>>& ashell, const std::vector<std::shared_ptr<const Shell>>& bshell,
+                               std::shared_ptr<const StaticDist> adist_shell, std::shared_ptr<const StaticDist> adist_averaged,
+                               const size_t asize, const size_t bsize, const size_t astart, const double thresh, const bool inverse) {
+      if (TBatch::Nblocks() != 1) throw std::logic_error("the single-precision storage is only available for the standard 3-index integrals");
+      single_block_ = std::make_shared<DFSingleBlock>(adist_shell, adist_averaged, asize, astart, bsize);
+
+      const int nbatch = 8;
+      const size_t batchsize = (asize-1) / nbatch + 1;
+      auto iter = ashell.begin();
+      size_t bstart = astart;
+      while (iter != ashell.end()) {
+        std::vector<std::shared_ptr<const Shell>> batch;
+        size_t bsz = 0;
+        for ( ; iter != ashell.end() && (batch.empty() || bsz + (*iter)->nbasis() <= batchsize); ++iter) {
+          batch.push_back(*iter);
+          bsz += (*iter)->nbasis();
+        }
+        block_.push_back(std::make_shared<DFBlock>(adist_shell, adist_averaged, bsz, bsize, bsize, bstart, 0, 0));
+        compute_3index(batch, bshell, bshell, bsz, bsize, bsize, bstart, thresh, inverse);
+        single_block_->fill(block_.front());
+        block_.clear();
+        bstart += bsz;
+      }
+    }
+
+    // only shell pairs whose Schwarz bound (rs|rs)^1/2 is above thresh are computed and stored
+    void compute_3index_sparse(const std::vector<std::shared_ptr<const Shell>>& ashell, const std::vector<std::shared_ptr<const Shell>>& bshell,
+                               std::shared_ptr<const StaticDist> adist_shell, const size_t, const size_t, const size_t, const double, std::false_type) {
+      throw std::logic_error("the sparse storage is only available for the standard 3-index integrals");
+    }
+    void compute_3index_sparse(const std::vector<std::shared_ptr<const Shell>>& ashell, const std::vector<std::shared_ptr<const Shell>>& bshell,
+                               std::shared_ptr<const StaticDist> adist_shell, const size_t asize, const size_t bsize, const size_t astart, const double thresh,
+                               std::true_type) {
+      Timer time;
+
+      std::vector<int> boffset;
+      int off = 0;
+      for (auto& i : bshell) {
+        boffset.push_back(off);
+        off += i->nbasis();
+      }
+
+      // Schwarz screening of the shell pairs
+      const int nshell = bshell.size();
+      std::vector<std::shared_ptr<const ShellPair>> allpairs(nshell*(nshell+1)/2);
+      TaskQueue<std::function<void(void)>> sptasks(nshell);
+      for (int j1 = 0; j1 != nshell; ++j1)
+        sptasks.emplace_back([&, j1]() {
+          for (int j0 = 0; j0 <= j1; ++j0)
+            allpairs[j0+j1*(j1+1)/2] = std::make_shared<const ShellPair>(std::array<std::shared_ptr<const Shell>,2>{{bshell[j0], bshell[j1]}},
+                                                                          std::array<int,2>{{boffset[j0], boffset[j1]}}, std::make_pair(j0, j1));
+        });
+      sptasks.compute();
+
+      std::vector<std::shared_ptr<const ShellPair>> pairs;
+      for (auto& p : allpairs)
+        if (p->schwarz() >= thresh)
+          pairs.push_back(p);
+      sparse_block_ = std::make_shared<DFSparseBlock>(adist_shell, asize, astart, bsize, pairs);
+      time.tick_print("3-index ints screening");
+
+      TaskQueue<DFSparseIntTask<TBatch>> tasks(pairs.size()*ashell.size());
+      auto i3 = std::make_shared<const Shell>(ashell.front()->spherical());
+      for (int ip = 0; ip != pairs.size(); ++ip) {
+        int j0 = 0;
+        for (auto& i0 : ashell) {
+          tasks.emplace_back((std::array<std::shared_ptr<const Shell>,4>{{i3, i0, pairs[ip]->shell(0), pairs[ip]->shell(1)}}), j0, sparse_block_, ip, omega_);
+          j0 += i0->nbasis();
+        }
+      }
+      tasks.compute();
+      time.tick_print("3-index ints");
+      std::cout << "       - " << std::left << std::setw(36) << "3-index ints (pairs kept)" << std::right << std::setw(10)
+                << pairs.size() << " / " << allpairs.size() << std::endl;
+    }
+
   public:
     DFDist_ints(const int nbas, const int naux, const std::vector<std::shared_ptr<const Atom>>& atoms, const std::vector<std::shared_ptr<const Atom>>& aux_atoms,
-                const double thr, const bool inverse, const double dum, const bool average = false, const std::shared_ptr<Matrix> data2 = nullptr, const bool serial = false)
+                const double thr, const bool inverse, const double omega, const bool average = false, const std::shared_ptr<Matrix> data2 = nullptr, const bool serial = false,
+                const double sparse_thresh = 0.0, const bool single = false)
       : DFDist(nbas, naux, nullptr, nullptr, nullptr, serial) {
+      omega_ = omega;
 
       // 3index Integral is now made in DFBlock.
       std::vector<std::shared_ptr<const Shell>> ashell, b1shell, b2shell;
@@ -146,11 +261,16 @@ class DFDist_ints : public DFDist {
       const size_t asize  = std::accumulate(myashell.begin(),myashell.end(),0, [](const int& i, const std::shared_ptr<const Shell>& o) { return i+o->nbasis(); });
       const size_t b1size = std::accumulate(b1shell.begin(), b1shell.end(), 0, [](const int& i, const std::shared_ptr<const Shell>& o) { return i+o->nbasis(); });
       const size_t b2size = std::accumulate(b2shell.begin(), b2shell.end(), 0, [](const int& i, const std::shared_ptr<const Shell>& o) { return i+o->nbasis(); });
-      for (int i = 0; i != TBatch::Nblocks(); ++i)
-        block_.push_back(std::make_shared<DFBlock>(adist_shell, adist_averaged, asize, b1size, b2size, astart, 0, 0));
-
       // 3-index integrals
-      compute_3index(myashell, b1shell, b2shell, asize, b1size, b2size, astart, thr, inverse);
+      if (sparse_thresh > 0.0) {
+        compute_3index_sparse(myashell, b1shell, adist_shell, asize, b1size, astart, sparse_thresh, std::integral_constant<bool, TBatch::Nblocks() == 1>());
+      } else if (single && !myashell.empty()) {
+        compute_3index_single(myashell, b1shell, adist_shell, adist_averaged, asize, b1size, astart, thr, inverse);
+      } else {
+        for (int i = 0; i != TBatch::Nblocks(); ++i)
+          block_.push_back(std::make_shared<DFBlock>(adist_shell, adist_averaged, asize, b1size, b2size, astart, 0, 0));
+        compute_3index(myashell, b1shell, b2shell, asize, b1size, b2size, astart, thr, inverse);
+      }
 
       // 2-index integrals
       if (data2)
@@ -158,9 +278,11 @@ class DFDist_ints : public DFDist {
       else
         compute_2index(ashell, thr, inverse);
 
-      // 3-index integrals, post process
-      if (average)
+      // 3-index integrals, post process (the sparse and single-precision storage stay at the shell boundary)
+      if (average && !sparse_block_ && !single_block_)
         average_3index();
+      if (single && !sparse_block_ && !single_block_)
+        convert_to_single();
     }
 
 };
@@ -194,6 +316,9 @@ class DFHalfDist : public ParallelDF {
 
     std::shared_ptr<Matrix> compute_Kop_1occ(const std::shared_ptr<const Matrix> den, const double a) const;
 
+    // exchange-type contraction a (D|ir)(D|it) in which negligible (D|i r) blocks are skipped
+    std::shared_ptr<Matrix> form_2index_screened(const std::vector<int>& bounds, const double thresh, const double a) const;
+
     std::shared_ptr<DFHalfDist> apply_J() const { return apply_J(df_->data2()); }
     std::shared_ptr<DFHalfDist> apply_JJ() const { return apply_J(std::make_shared<Matrix>(*df_->data2()**df_->data2())); }
     std::shared_ptr<DFHalfDist> apply_J(const std::shared_ptr<const DFDist> d) const { return apply_J(d->data2()); }
@@ -22,6 +22,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <map>
 #include <src/df/dfblock.h>
 
 using namespace bagel;
@@ -36,6 +37,8 @@ DFBlock::DFBlock(shared_ptr<const StaticDist> adist_shell, shared_ptr<const Stat
 
   assert(asize() == adist_shell->size(mpi__->rank()) || asize() == adist_->size(mpi__->rank()) || asize() == adist_->nele());
 
+  Profiler::allocated(this->storage().size()*sizeof(double));
+
   // resize to the current size (moving the end pointer)
   const btas::CRange<3> range(a, b1, b2);
   this->resize(range);
@@ -90,6 +93,103 @@ shared_ptr<DFBlock> DFBlock::transform_third(const MatView cmat, const bool tran
 }
 
 
+vector<double> DFBlock::block_max(const vector<int>& bounds) const {
+  assert(b1size() == b2size() && bounds.back() == b1size());
+  const int nbasis = b1size();
+  const int nblock = bounds.size()-1;
+  const size_t asz = asize();
+  vector<double> out(nblock*nblock, 0.0);
+  for (int sb = 0; sb != nblock; ++sb)
+    for (int s = bounds[sb]; s != bounds[sb+1]; ++s)
+      for (int rb = 0; rb != nblock; ++rb) {
+        const double* ptr = data() + asz*(bounds[rb]+nbasis*s);
+        const double* end = data() + asz*(bounds[rb+1]+nbasis*s);
+        double& m = out[rb+nblock*sb];
+        for ( ; ptr != end; ++ptr)
+          m = max(m, fabs(*ptr));
+      }
+  return out;
+}
+
+
+shared_ptr<DFBlock> DFBlock::transform_second_screened(const MatView cmat, const vector<int>& bounds, const vector<double>& intmax, const double thresh) const {
+  assert(cmat.extent(0) == b1size() && cmat.range().ordinal().contiguous());
+  assert(b1start_ == 0 && b1size() == b2size() && bounds.back() == b1size());
+  const int nocc = cmat.extent(1);
+  const int nbasis = b1size();
+  const int nblock = bounds.size()-1;
+  const size_t asz = asize();
+  assert(intmax.size() == nblock*nblock);
+  auto out = make_shared<DFBlock>(adist_shell_, adist_, asz, nocc, b2size(), astart_, 0, b2start_, averaged_);
+  out->zero();
+  if (asz == 0 || nocc == 0)
+    return out;
+
+  // largest coefficient of each orbital in each block
+  vector<double> cmax(nblock*nocc, 0.0);
+  for (int i = 0; i != nocc; ++i)
+    for (int rb = 0; rb != nblock; ++rb)
+      for (int r = bounds[rb]; r != bounds[rb+1]; ++r)
+        cmax[rb+nblock*i] = max(cmax[rb+nblock*i], fabs(cmat(r, i)));
+
+  // (D|i s) = (D|r s) c_ri, one task per block of s. The orbitals that need the same blocks of r are contracted together by dgemm.
+  TaskQueue<function<void(void)>> tasks(nblock);
+  for (int sb = 0; sb != nblock; ++sb)
+    tasks.emplace_back([&, sb]() {
+      map<vector<char>, vector<int>> groups;
+      for (int i = 0; i != nocc; ++i) {
+        vector<char> pattern(nblock);
+        bool any = false;
+        for (int rb = 0; rb != nblock; ++rb) {
+          pattern[rb] = intmax[rb+nblock*sb]*cmax[rb+nblock*i] >= thresh;
+          any |= pattern[rb];
+        }
+        if (any)
+          groups[pattern].push_back(i);
+      }
+
+      vector<double> coeff, work;
+      for (auto& g : groups) {
+        const vector<char>& pattern = g.first;
+        const vector<int>& orbs = g.second;
+        const int norb = orbs.size();
+
+        // runs of consecutive significant blocks of r, and the corresponding coefficients
+        vector<pair<int,int>> runs;
+        for (int rb = 0; rb != nblock; ) {
+          if (!pattern[rb]) { ++rb; continue; }
+          const int r0 = bounds[rb];
+          while (rb != nblock && pattern[rb]) ++rb;
+          runs.emplace_back(r0, bounds[rb]-r0);
+        }
+        int nrow = 0;
+        for (auto& r : runs) nrow += r.second;
+        coeff.resize(nrow*norb);
+        for (int j = 0; j != norb; ++j) {
+          int row = 0;
+          for (auto& r : runs) {
+            copy_n(cmat.data()+r.first+nbasis*orbs[j], r.second, coeff.data()+row+nrow*j);
+            row += r.second;
+          }
+        }
+
+        work.resize(asz*norb);
+        for (int s = bounds[sb]; s != bounds[sb+1]; ++s) {
+          int row = 0;
+          for (auto& r : runs) {
+            dgemm_("N", "N", asz, norb, r.second, 1.0, data()+asz*(r.first+nbasis*s), asz, coeff.data()+row, nrow, (row == 0 ? 0.0 : 1.0), work.data(), asz);
+            row += r.second;
+          }
+          for (int j = 0; j != norb; ++j)
+            copy_n(work.data()+asz*j, asz, out->data()+asz*(orbs[j]+nocc*s));
+        }
+      }
+    });
+  tasks.compute();
+  return out;
+}
+
+
 shared_ptr<DFBlock> DFBlock::merge_b1(shared_ptr<const DFBlock> o) const {
   assert(asize() == o->asize() && b2size() == o->b2size());
   assert(astart() == o->astart() && b1start() == o->b1start() && b2start() == o->b2start());
@@ -371,6 +471,52 @@ shared_ptr<Matrix> DFBlock::form_2index(const shared_ptr<const DFBlock> o, const
 }
 
 
+// Blocks r of (D|i r) are dropped for orbital i when |(D|ir)| |(D|it)| is below thresh for every block t (Cauchy-Schwarz).
+shared_ptr<Matrix> DFBlock::form_2index_screened(const vector<int>& bounds, const double thresh, const double a) const {
+  assert(bounds.back() == b2size());
+  const int nocc = b1size();
+  const int nbasis = b2size();
+  const int nblock = bounds.size()-1;
+  const size_t asz = asize();
+  auto target = make_shared<Matrix>(nbasis, nbasis);
+  if (asz == 0)
+    return target;
+
+  vector<double> norm(nblock*nocc, 0.0);
+  for (int i = 0; i != nocc; ++i)
+    for (int rb = 0; rb != nblock; ++rb) {
+      double sum = 0.0;
+      for (int r = bounds[rb]; r != bounds[rb+1]; ++r)
+        sum += blas::dot_product(data()+asz*(i+nocc*r), asz, data()+asz*(i+nocc*r));
+      norm[rb+nblock*i] = sqrt(sum);
+    }
+
+  vector<int> rows;
+  vector<double> gathered, local;
+  for (int i = 0; i != nocc; ++i) {
+    const double nmax = *max_element(norm.begin()+nblock*i, norm.begin()+nblock*(i+1));
+    rows.clear();
+    for (int rb = 0; rb != nblock; ++rb)
+      if (norm[rb+nblock*i]*nmax >= thresh)
+        for (int r = bounds[rb]; r != bounds[rb+1]; ++r)
+          rows.push_back(r);
+    const int nrow = rows.size();
+    if (nrow == 0)
+      continue;
+
+    gathered.resize(asz*nrow);
+    for (int j = 0; j != nrow; ++j)
+      copy_n(data()+asz*(i+nocc*rows[j]), asz, gathered.data()+asz*j);
+    local.resize(nrow*nrow);
+    dgemm_("T", "N", nrow, nrow, asz, a, gathered.data(), asz, gathered.data(), asz, 0.0, local.data(), nrow);
+    for (int k = 0; k != nrow; ++k)
+      for (int j = 0; j != nrow; ++j)
+        target->element(rows[j], rows[k]) += local[j+nrow*k];
+  }
+  return target;
+}
+
+
 shared_ptr<Matrix> DFBlock::form_4index(const shared_ptr<const DFBlock> o, const double a) const {
   if (asize() != o->asize()) throw logic_error("illegal call of DFBlock::form_4index");
   auto target = make_shared<Matrix>(b1size()*b2size(), o->b1size()*o->b2size());
@@ -85,6 +85,8 @@ class DFBlock : public btas::Tensor3<double> {
 
     // dist
     const std::shared_ptr<const StaticDist>& adist_now() const { return averaged_ ? adist_ : adist_shell_; }
+    const std::shared_ptr<const StaticDist>& adist_shell() const { return adist_shell_; }
+    const std::shared_ptr<const StaticDist>& adist() const { return adist_; }
 
 
     // some math functions
@@ -121,6 +123,11 @@ class DFBlock : public btas::Tensor3<double> {
 
     std::shared_ptr<DFBlock> transform_second(const MatView c, const bool trans = false) const;
     std::shared_ptr<DFBlock> transform_third(const MatView c, const bool trans = false) const;
+    // largest |(D|rs)| for each pair of blocks of basis functions delimited by bounds
+    std::vector<double> block_max(const std::vector<int>& bounds) const;
+    // transform_second in which blocks of basis functions (delimited by bounds) with estimated contributions below thresh are skipped;
+    // intmax is the output of block_max
+    std::shared_ptr<DFBlock> transform_second_screened(const MatView c, const std::vector<int>& bounds, const std::vector<double>& intmax, const double thresh) const;
 
     std::shared_ptr<DFBlock> merge_b1(std::shared_ptr<const DFBlock> o) const;
     std::shared_ptr<DFBlock> slice_b1(const int start, const int size) const;
@@ -140,6 +147,8 @@ class DFBlock : public btas::Tensor3<double> {
 
     // Form 2- and 4-index integrals
     std::shared_ptr<Matrix> form_2index(const std::shared_ptr<const DFBlock> o, const double a) const;
+    // a (D|ir)(D|it) summed over D and i, skipping the (D|i r) blocks whose norms are negligible
+    std::shared_ptr<Matrix> form_2index_screened(const std::vector<int>& bounds, const double thresh, const double a) const;
     std::shared_ptr<Matrix> form_4index(const std::shared_ptr<const DFBlock> o, const double a) const;
     // slowest index of o is fixed to n
     std::shared_ptr<Matrix> form_4index_1fixed(const std::shared_ptr<const DFBlock> o, const double a, const size_t n) const;
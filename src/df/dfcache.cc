@@ -0,0 +1,183 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: dfcache.cc
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <src/df/dfcache.h>
+#include <src/util/io/chunkfile.h>
+#include <src/util/hash.h>
+
+using namespace std;
+using namespace bagel;
+
+namespace {
+
+// bump this when the layout of the files changes
+const char magic__[8] = {'B', 'A', 'G', 'E', 'L', 'D', 'F', '1'};
+
+struct Header {
+  char magic[8];
+  uint64_t key;
+  uint64_t nbasis;
+  uint64_t naux;
+  uint64_t asize;
+  uint64_t astart;
+  uint64_t nproc;
+};
+
+void write_file(const string& file, const Header& header, const vector<pair<const void*, size_t>>& data) {
+  // written under a temporary name so that an interrupted job never leaves a truncated cache behind
+  const string tmp = file + ".tmp" + to_string(getpid());
+  {
+    ofstream fs(tmp, ios::binary | ios::trunc);
+    fs.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    for (auto& i : data)
+      fs.write(static_cast<const char*>(i.first), i.second);
+    if (!fs.good())
+      throw runtime_error("DFCache could not write " + tmp);
+  }
+  if (rename(tmp.c_str(), file.c_str()) != 0)
+    throw runtime_error("DFCache could not rename " + tmp);
+}
+
+}
+
+
+DFCache::DFCache(const string directory, const int nbasis, const int naux, const vector<shared_ptr<const Atom>>& atoms,
+                 const vector<shared_ptr<const Atom>>& aux_atoms, const double thresh, const string tag)
+ : directory_(directory), key_(compute_key(atoms, aux_atoms, thresh, tag)), nbasis_(nbasis), naux_(naux) {
+}
+
+
+string DFCache::compute_key(const vector<shared_ptr<const Atom>>& atoms, const vector<shared_ptr<const Atom>>& aux_atoms, const double thresh, const string& tag) {
+  Hash hash;
+  hash.add(string(magic__, 8));
+  hash.add(tag);
+  hash.add(thresh);
+  // the distribution of the auxiliary index depends on the number of processes
+  hash.add(mpi__->size());
+  for (auto& list : {atoms, aux_atoms}) {
+    hash.add(list.size());
+    for (auto& atom : list) {
+      hash.add(atom->name());
+      hash.add(atom->position());
+      hash.add(atom->shells().size());
+      for (auto& shell : atom->shells()) {
+        hash.add(shell->angular_number());
+        hash.add(shell->spherical());
+        hash.add(shell->exponents());
+        hash.add(shell->contractions().size());
+        for (auto& c : shell->contractions())
+          hash.add(c);
+        hash.add(shell->contraction_ranges());
+      }
+    }
+  }
+  stringstream ss;
+  ss << hex << setw(16) << setfill('0') << hash.hash();
+  return ss.str();
+}
+
+
+string DFCache::block_file() const {
+  return directory_ + "/df_" + key_ + "." + to_string(mpi__->rank()) + "of" + to_string(mpi__->size());
+}
+
+
+string DFCache::metric_file() const {
+  return directory_ + "/df_" + key_ + ".j";
+}
+
+
+shared_ptr<DFDist> DFCache::load() const {
+  const uint64_t key = stoull(key_, nullptr, 16);
+  const size_t nproc = mpi__->size();
+
+  MappedFile bfile(block_file());
+  MappedFile mfile(metric_file());
+
+  auto valid = [&](const MappedFile& f, const size_t size) {
+    if (!f.good() || f.size() < sizeof(Header)) return false;
+    const Header* h = reinterpret_cast<const Header*>(f.data());
+    return equal(magic__, magic__+8, h->magic) && h->key == key && h->nbasis == static_cast<uint64_t>(nbasis_)
+        && h->naux == static_cast<uint64_t>(naux_) && h->nproc == nproc && f.size() == sizeof(Header) + size;
+  };
+  const Header* bheader = reinterpret_cast<const Header*>(bfile.data());
+  const size_t asize = bfile.good() && bfile.size() >= sizeof(Header) ? bheader->asize : 0;
+  const size_t bsize = (nproc+1)*sizeof(size_t) + asize*nbasis_*nbasis_*sizeof(double);
+
+  // every process has to find its files; otherwise all of them recompute the integrals
+  int found = valid(bfile, bsize) && valid(mfile, static_cast<size_t>(naux_)*naux_*sizeof(double));
+  mpi__->allreduce(&found, 1);
+  if (found != static_cast<int>(nproc))
+    return nullptr;
+
+  const size_t* table = reinterpret_cast<const size_t*>(bfile.data() + sizeof(Header));
+  auto adist_shell = make_shared<const StaticDist>(vector<size_t>(table, table+nproc+1));
+  auto adist_averaged = make_shared<const StaticDist>(naux_, nproc);
+  auto block = make_shared<DFBlock>(adist_shell, adist_averaged, asize, nbasis_, nbasis_, bheader->astart, 0, 0);
+  const double* bdata = reinterpret_cast<const double*>(table + nproc+1);
+  copy_n(bdata, block->size(), block->data());
+
+  auto data2 = make_shared<Matrix>(naux_, naux_, true);
+  copy_n(reinterpret_cast<const double*>(mfile.data() + sizeof(Header)), data2->size(), data2->data());
+
+  return make_shared<DFDist>(nbasis_, naux_, block, nullptr, data2);
+}
+
+
+void DFCache::save(shared_ptr<const DFDist> df) const {
+  assert(df->block().size() == 1 && df->has_2index());
+  shared_ptr<const DFBlock> block = df->block(0);
+  shared_ptr<const StaticDist> adist = block->adist_now();
+
+  mkdir(directory_.c_str(), 0755);
+
+  Header header;
+  copy_n(magic__, 8, header.magic);
+  header.key = stoull(key_, nullptr, 16);
+  header.nbasis = nbasis_;
+  header.naux = naux_;
+  header.asize = block->asize();
+  header.astart = block->astart();
+  header.nproc = mpi__->size();
+
+  vector<size_t> table;
+  for (size_t i = 0; i != header.nproc; ++i)
+    table.push_back(adist->start(i));
+  table.push_back(adist->nele());
+
+  write_file(block_file(), header, {{table.data(), table.size()*sizeof(size_t)}, {block->data(), block->size()*sizeof(double)}});
+
+  if (mpi__->rank() == 0) {
+    header.asize = naux_;
+    header.astart = 0;
+    write_file(metric_file(), header, {{df->data2()->data(), df->data2()->size()*sizeof(double)}});
+  }
+}
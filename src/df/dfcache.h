@@ -0,0 +1,65 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: dfcache.h
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __SRC_DF_DFCACHE_H
+#define __SRC_DF_DFCACHE_H
+
+#include <src/df/df.h>
+
+namespace bagel {
+
+// On-disk cache of the 3-index integrals and J^-1/2 of DFDist_ints.
+// The files are keyed by a hash of everything the integrals depend on (atoms, basis sets, thresholds,
+// and the number of processes), so that a later job with the same molecule can map them instead of recomputing.
+// Each process writes its own block to "df_<key>.<rank>of<nproc>"; J^-1/2 is written once by rank 0 to "df_<key>.j".
+class DFCache {
+  protected:
+    const std::string directory_;
+    const std::string key_;
+
+    const int nbasis_;
+    const int naux_;
+
+    std::string block_file() const;
+    std::string metric_file() const;
+
+    static std::string compute_key(const std::vector<std::shared_ptr<const Atom>>& atoms, const std::vector<std::shared_ptr<const Atom>>& aux_atoms,
+                                   const double thresh, const std::string& tag);
+
+  public:
+    DFCache(const std::string directory, const int nbasis, const int naux, const std::vector<std::shared_ptr<const Atom>>& atoms,
+            const std::vector<std::shared_ptr<const Atom>>& aux_atoms, const double thresh, const std::string tag);
+
+    // returns nullptr unless all of the processes find their files (collective)
+    std::shared_ptr<DFDist> load() const;
+    // writes the integrals of this process to the cache
+    void save(std::shared_ptr<const DFDist> df) const;
+
+    const std::string& key() const { return key_; }
+};
+
+}
+
+#endif
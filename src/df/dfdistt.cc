@@ -33,6 +33,8 @@ DFDistT::DFDistT(shared_ptr<const ParallelDF> in, shared_ptr<const StaticDist> d
    dist_(dist ? dist : make_shared<StaticDist>(nindex1_*nindex2_, mpi__->size())),
    bstart_(dist_->start(mpi__->rank())), bsize_(dist_->size(mpi__->rank())), df_(in->df()) {
 
+  if (in->block().empty()) throw logic_error("DFDistT requires dense 3-index blocks (sparse or single-precision storage?)");
+
   vector<int> srequest;
   const int myrank = mpi__->rank();
 
@@ -26,6 +26,7 @@
 #define __SRC_DF_DFINTTASK_H
 
 #include <src/df/dfblock.h>
+#include <src/df/dfsparseblock.h>
 #include <src/molecule/shell.h>
 
 namespace bagel {
@@ -36,16 +37,35 @@ class DFIntTask {
     const std::array<std::shared_ptr<const Shell>,4> shell_;
     const std::array<int,3> offset_; // at most 3 elements
     std::array<std::shared_ptr<DFBlock>,N> dfblocks_;
+    // range-separation parameter for erf-attenuated integrals (only for batches that take it)
+    const double omega_;
+
+    std::shared_ptr<TBatch> make_batch(const std::array<std::shared_ptr<const Shell>,4>& input, std::true_type) const {
+      return std::make_shared<TBatch>(input, 2.0, omega_);
+    }
+    std::shared_ptr<TBatch> make_batch(const std::array<std::shared_ptr<const Shell>,4>& input, std::false_type) const {
+      if (omega_ != 0.0)
+        throw std::logic_error("attenuated integrals are not available for this integral batch");
+      return std::make_shared<TBatch>(input, 2.0);
+    }
 
     std::shared_ptr<TBatch> compute_batch(const std::array<std::shared_ptr<const Shell>,4>& input) const {
-      auto eribatch = std::make_shared<TBatch>(input, 2.0);
+      auto eribatch = make_batch(input, std::is_constructible<TBatch, const std::array<std::shared_ptr<const Shell>,4>&, double, double>());
       eribatch->compute();
       return eribatch;
     }
 
   public:
-    DFIntTask(std::array<std::shared_ptr<const Shell>,4>&& a, std::array<int,3>&& b, std::array<std::shared_ptr<DFBlock>,N>& df)
-     : shell_(a), offset_(b), dfblocks_(df) { };
+    DFIntTask(std::array<std::shared_ptr<const Shell>,4>&& a, std::array<int,3>&& b, std::array<std::shared_ptr<DFBlock>,N>& df, const double omega = 0.0)
+     : shell_(a), offset_(b), dfblocks_(df), omega_(omega) { };
+
+    // rough operation count, used by TaskQueue to start the high angular momentum triples first
+    double cost() const {
+      double out = 1.0;
+      for (int i = 1; i != 4; ++i)
+        out *= shell_[i]->nbasis() * shell_[i]->num_primitive();
+      return out;
+    }
 
     void compute() {
       std::shared_ptr<TBatch> p = compute_batch(shell_);
@@ -69,6 +89,51 @@ class DFIntTask {
 };
 
 
+// fills one shell pair of a DFSparseBlock for one auxiliary shell
+template <typename TBatch>
+class DFSparseIntTask {
+  protected:
+    const std::array<std::shared_ptr<const Shell>,4> shell_;
+    const int aoffset_;
+    std::shared_ptr<DFSparseBlock> sparse_;
+    const int pair_;
+    const double omega_;
+
+    std::shared_ptr<TBatch> make_batch(std::true_type) const { return std::make_shared<TBatch>(shell_, 2.0, omega_); }
+    std::shared_ptr<TBatch> make_batch(std::false_type) const {
+      if (omega_ != 0.0)
+        throw std::logic_error("attenuated integrals are not available for this integral batch");
+      return std::make_shared<TBatch>(shell_, 2.0);
+    }
+
+  public:
+    DFSparseIntTask(std::array<std::shared_ptr<const Shell>,4>&& a, const int aoffset, std::shared_ptr<DFSparseBlock> sp, const int pair, const double omega = 0.0)
+     : shell_(a), aoffset_(aoffset), sparse_(sp), pair_(pair), omega_(omega) { }
+
+    double cost() const {
+      double out = 1.0;
+      for (int i = 1; i != 4; ++i)
+        out *= shell_[i]->nbasis() * shell_[i]->num_primitive();
+      return out;
+    }
+
+    void compute() {
+      std::shared_ptr<TBatch> batch = make_batch(std::is_constructible<TBatch, const std::array<std::shared_ptr<const Shell>,4>&, double, double>());
+      batch->compute();
+
+      const size_t naux = sparse_->asize();
+      const int na = shell_[1]->nbasis();
+      const int n0 = shell_[2]->nbasis();
+      const int n1 = shell_[3]->nbasis();
+      assert(n0 == sparse_->pair(pair_).size0 && n1 == sparse_->pair(pair_).size1);
+      const double* ppt = batch->data(0);
+      double* const data = sparse_->data(pair_) + aoffset_;
+      for (int j1 = 0; j1 != n1; ++j1)
+        for (int j0 = 0; j0 != n0; ++j0, ppt += na)
+          std::copy_n(ppt, na, data+naux*(j0+n0*j1));
+    }
+};
+
 }
 
 #endif
@@ -0,0 +1,148 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: dfsingleblock.cc
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <src/df/dfsingleblock.h>
+
+using namespace bagel;
+using namespace std;
+
+DFSingleBlock::DFSingleBlock(shared_ptr<const DFBlock> o)
+ : adist_shell_(o->adist_shell()), adist_(o->adist()), averaged_(o->averaged()), asize_(o->asize()), astart_(o->astart()), nbasis_(o->b1size()) {
+  if (o->b1size() != o->b2size() || o->b1start() != 0 || o->b2start() != 0)
+    throw logic_error("DFSingleBlock is only for the 3-index AO integrals");
+
+  const size_t n = size();
+  data_ = unique_ptr<float[]>(new float[n]);
+  Profiler::allocated(n*sizeof(float));
+  copy_n(o->data(), n, data_.get());
+}
+
+
+DFSingleBlock::DFSingleBlock(shared_ptr<const StaticDist> adist_shell, shared_ptr<const StaticDist> adist, const size_t asize, const size_t astart, const size_t nbasis)
+ : adist_shell_(adist_shell), adist_(adist), averaged_(false), asize_(asize), astart_(astart), nbasis_(nbasis) {
+  const size_t n = size();
+  data_ = unique_ptr<float[]>(new float[n]);
+  Profiler::allocated(n*sizeof(float));
+}
+
+
+void DFSingleBlock::fill(shared_ptr<const DFBlock> o) {
+  if (o->b1size() != nbasis_ || o->b2size() != nbasis_ || o->astart() < astart_ || o->astart()+o->asize() > astart_+asize_)
+    throw logic_error("illegal call of DFSingleBlock::fill");
+  const size_t na = o->asize();
+  const size_t offset = o->astart() - astart_;
+  for (size_t rs = 0; rs != nbasis_*nbasis_; ++rs)
+    copy_n(o->data()+na*rs, na, data_.get()+offset+asize_*rs);
+}
+
+
+shared_ptr<DFBlock> DFSingleBlock::transform_second(const MatView cmat) const {
+  assert(cmat.extent(0) == nbasis_ && cmat.range().ordinal().contiguous());
+  const int nocc = cmat.extent(1);
+  auto out = make_shared<DFBlock>(adist_shell_, adist_, asize_, nocc, nbasis_, astart_, 0, 0, averaged_);
+  if (nocc == 0 || asize_ == 0) {
+    out->zero();
+    return out;
+  }
+
+  unique_ptr<float[]> coeff(new float[nbasis_*nocc]);
+  copy_n(cmat.data(), nbasis_*nocc, coeff.get());
+
+  // (D|s i) = (D|s r) c_ri, using the symmetry (D|sr) = (D|rs)
+  const size_t ld = asize_*nbasis_;
+  unique_ptr<float[]> work(new float[ld*nocc]);
+  sgemm_("N", "N", ld, nocc, nbasis_, 1.0f, data_.get(), ld, coeff.get(), nbasis_, 0.0f, work.get(), ld);
+
+  // reorder to (D|i s) in double precision
+  for (int i = 0; i != nocc; ++i)
+    for (size_t s = 0; s != nbasis_; ++s)
+      copy_n(work.get()+asize_*(s+nbasis_*i), asize_, out->data()+asize_*(i+nocc*s));
+  return out;
+}
+
+
+shared_ptr<VectorB> DFSingleBlock::form_vec(const shared_ptr<const Matrix> den) const {
+  assert(den->ndim() == nbasis_ && den->mdim() == nbasis_);
+  auto out = make_shared<VectorB>(asize_);
+
+  // the aux index is split among the tasks so that each of them accumulates into its own part of out
+  const size_t chunk = 256;
+  TaskQueue<function<void(void)>> tasks((asize_-1)/chunk+1);
+  for (size_t d0 = 0; d0 < asize_; d0 += chunk)
+    tasks.emplace_back([&, d0]() {
+      const size_t nd = min(chunk, asize_-d0);
+      double* const target = out->data() + d0;
+      for (size_t s = 0; s != nbasis_; ++s)
+        for (size_t r = 0; r != nbasis_; ++r) {
+          const double d = den->element(r, s);
+          const float* x = data_.get() + d0 + asize_*(r+nbasis_*s);
+          for (size_t i = 0; i != nd; ++i)
+            target[i] += d * x[i];
+        }
+    });
+  tasks.compute();
+  return out;
+}
+
+
+shared_ptr<Matrix> DFSingleBlock::form_mat(const btas::Tensor1<double>& fit) const {
+  assert(fit.size() == asize_);
+  auto out = make_shared<Matrix>(nbasis_, nbasis_);
+
+  TaskQueue<function<void(void)>> tasks(nbasis_);
+  for (size_t s = 0; s != nbasis_; ++s)
+    tasks.emplace_back([&, s]() {
+      for (size_t r = 0; r <= s; ++r) {
+        const float* x = data_.get() + asize_*(r+nbasis_*s);
+        double sum = 0.0;
+        for (size_t i = 0; i != asize_; ++i)
+          sum += x[i] * fit(i);
+        out->element(r, s) = sum;
+        out->element(s, r) = sum;
+      }
+    });
+  tasks.compute();
+  return out;
+}
+
+
+// out_st = a (D|rs)(D|rt); the integrals are converted to double precision in slices of s
+shared_ptr<Matrix> DFSingleBlock::form_2index(const shared_ptr<const DFBlock> o, const double a) const {
+  if (asize_ != o->asize() || nbasis_ != o->b1size()) throw logic_error("illegal call of DFSingleBlock::form_2index");
+  const int ndim = o->b2size();
+  auto out = make_shared<Matrix>(nbasis_, ndim);
+  if (asize_ == 0)
+    return out;
+
+  const size_t ld = asize_*nbasis_;
+  const size_t nslice = max(static_cast<size_t>(1), min(nbasis_, (static_cast<size_t>(1) << 22) / ld));
+  unique_ptr<double[]> work(new double[ld*nslice]);
+  for (size_t s0 = 0; s0 < nbasis_; s0 += nslice) {
+    const size_t ns = min(nslice, nbasis_-s0);
+    copy_n(data_.get()+ld*s0, ld*ns, work.get());
+    dgemm_("T", "N", ns, ndim, ld, a, work.get(), ld, o->data(), ld, 0.0, out->element_ptr(s0, 0), nbasis_);
+  }
+  return out;
+}
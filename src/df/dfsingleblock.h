@@ -0,0 +1,76 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: dfsingleblock.h
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef __SRC_DF_DFSINGLEBLOCK_H
+#define __SRC_DF_DFSINGLEBLOCK_H
+
+#include <src/df/dfblock.h>
+
+namespace bagel {
+
+/*
+    DFSingleBlock holds 3-index AO integrals (D|rs) in single precision (same layout as DFBlock, aux index fastest).
+    The half transformation is done by SGEMM; all the other contractions accumulate in double precision.
+*/
+
+class DFSingleBlock {
+  protected:
+    std::shared_ptr<const StaticDist> adist_shell_;
+    std::shared_ptr<const StaticDist> adist_;
+    bool averaged_;
+
+    size_t asize_;
+    size_t astart_;
+    size_t nbasis_;
+
+    std::unique_ptr<float[]> data_;
+
+  public:
+    // o has to be symmetric in the two AO indices
+    DFSingleBlock(std::shared_ptr<const DFBlock> o);
+    // uninitialized storage, to be filled slab by slab of the auxiliary index using fill()
+    DFSingleBlock(std::shared_ptr<const StaticDist> adist_shell, std::shared_ptr<const StaticDist> adist, const size_t asize, const size_t astart, const size_t nbasis);
+
+    size_t asize() const { return asize_; }
+    size_t astart() const { return astart_; }
+    size_t nbasis() const { return nbasis_; }
+    size_t size() const { return asize_*nbasis_*nbasis_; }
+
+    const std::shared_ptr<const StaticDist>& adist_now() const { return averaged_ ? adist_ : adist_shell_; }
+
+    // copies the integrals of o, which covers a contiguous part of the auxiliary index of this block
+    void fill(std::shared_ptr<const DFBlock> o);
+
+    // the same as the DFBlock counterparts; the results are in double precision
+    std::shared_ptr<DFBlock> transform_second(const MatView c) const;
+    std::shared_ptr<VectorB> form_vec(const std::shared_ptr<const Matrix> den) const;
+    std::shared_ptr<Matrix> form_mat(const btas::Tensor1<double>& fit) const;
+    std::shared_ptr<Matrix> form_2index(const std::shared_ptr<const DFBlock> o, const double a) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,128 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: dfsparseblock.cc
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <src/df/dfsparseblock.h>
+
+using namespace bagel;
+using namespace std;
+
+DFSparseBlock::DFSparseBlock(shared_ptr<const StaticDist> adist_shell, const size_t asize, const size_t astart, const size_t nbasis,
+                             const vector<shared_ptr<const ShellPair>>& pairs)
+ : adist_shell_(adist_shell), asize_(asize), astart_(astart), nbasis_(nbasis), size_(0lu) {
+
+  for (auto& p : pairs) {
+    assert(p->offset(0) <= p->offset(1));
+    pairs_.push_back({p->offset(0), p->nbasis0(), p->offset(1), p->nbasis1(), size_});
+    size_ += asize_ * p->nbasis0() * p->nbasis1();
+  }
+  data_ = unique_ptr<double[]>(new double[size_]);
+  fill_n(data_.get(), size_, 0.0);
+  Profiler::allocated(size_*sizeof(double));
+}
+
+
+shared_ptr<DFBlock> DFSparseBlock::transform_second(const MatView cmat) const {
+  assert(cmat.extent(0) == nbasis_ && cmat.range().ordinal().contiguous());
+  const int nocc = cmat.extent(1);
+  auto out = make_shared<DFBlock>(adist_shell_, adist_shell_, asize_, nocc, nbasis_, astart_, 0, 0);
+  out->zero();
+  if (nocc == 0 || asize_ == 0)
+    return out;
+
+  for (auto& p : pairs_) {
+    const double* block = data_.get() + p.pos;
+    // (D|i s) += (D|r s) c_ri
+    for (int n = 0; n != p.size1; ++n)
+      dgemm_("N", "N", asize_, nocc, p.size0, 1.0, block+n*asize_*p.size0, asize_, cmat.data()+p.offset0, nbasis_,
+             1.0, out->data()+(p.offset1+n)*asize_*nocc, asize_);
+    // (D|i r) += (D|r s) c_si
+    if (p.offset0 != p.offset1)
+      for (int m = 0; m != p.size0; ++m)
+        dgemm_("N", "N", asize_, nocc, p.size1, 1.0, block+m*asize_, asize_*p.size0, cmat.data()+p.offset1, nbasis_,
+               1.0, out->data()+(p.offset0+m)*asize_*nocc, asize_);
+  }
+  return out;
+}
+
+
+shared_ptr<VectorB> DFSparseBlock::form_vec(const shared_ptr<const Matrix> den) const {
+  assert(den->ndim() == nbasis_ && den->mdim() == nbasis_);
+  auto out = make_shared<VectorB>(asize_);
+  vector<double> d;
+  for (auto& p : pairs_) {
+    d.resize(p.size0 * p.size1);
+    for (int n = 0; n != p.size1; ++n)
+      for (int m = 0; m != p.size0; ++m)
+        d[m+p.size0*n] = den->element(p.offset0+m, p.offset1+n) + (p.offset0 != p.offset1 ? den->element(p.offset1+n, p.offset0+m) : 0.0);
+    dgemv_("N", asize_, p.size0*p.size1, 1.0, data_.get()+p.pos, asize_, d.data(), 1, 1.0, out->data(), 1);
+  }
+  return out;
+}
+
+
+shared_ptr<Matrix> DFSparseBlock::form_mat(const btas::Tensor1<double>& fit) const {
+  assert(fit.size() == asize_);
+  auto out = make_shared<Matrix>(nbasis_, nbasis_);
+  vector<double> d;
+  for (auto& p : pairs_) {
+    d.resize(p.size0 * p.size1);
+    dgemv_("T", asize_, p.size0*p.size1, 1.0, data_.get()+p.pos, asize_, fit.data(), 1, 0.0, d.data(), 1);
+    for (int n = 0; n != p.size1; ++n)
+      for (int m = 0; m != p.size0; ++m) {
+        out->element(p.offset0+m, p.offset1+n) = d[m+p.size0*n];
+        out->element(p.offset1+n, p.offset0+m) = d[m+p.size0*n];
+      }
+  }
+  return out;
+}
+
+
+// the sparse counterpart of DFBlock::form_2index when the first indices are contracted: out_st = a (D|rs)(D|rt)
+shared_ptr<Matrix> DFSparseBlock::form_2index(const shared_ptr<const DFBlock> o, const double a) const {
+  if (asize_ != o->asize() || nbasis_ != o->b1size()) throw logic_error("illegal call of DFSparseBlock::form_2index");
+  const int ndim = o->b2size();
+  auto out = make_shared<Matrix>(nbasis_, ndim);
+  if (asize_ == 0)
+    return out;
+
+  const int ld = asize_ * nbasis_;
+  vector<double> tmp;
+  for (auto& p : pairs_) {
+    const double* block = data_.get() + p.pos;
+    // rows of s: (D|rs)(D|rt) summed over D and r
+    dgemm_("T", "N", p.size1, ndim, asize_*p.size0, a, block, asize_*p.size0, o->data()+asize_*p.offset0, ld,
+           1.0, out->element_ptr(p.offset1, 0), nbasis_);
+    // rows of r: (D|sr)(D|st), for which the block is reordered to D, s, r
+    if (p.offset0 != p.offset1) {
+      tmp.resize(asize_ * p.size0 * p.size1);
+      for (int m = 0; m != p.size0; ++m)
+        for (int n = 0; n != p.size1; ++n)
+          copy_n(block+asize_*(m+p.size0*n), asize_, tmp.data()+asize_*(n+p.size1*m));
+      dgemm_("T", "N", p.size0, ndim, asize_*p.size1, a, tmp.data(), asize_*p.size1, o->data()+asize_*p.offset1, ld,
+             1.0, out->element_ptr(p.offset0, 0), nbasis_);
+    }
+  }
+  return out;
+}
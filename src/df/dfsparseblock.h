@@ -0,0 +1,83 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: dfsparseblock.h
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef __SRC_DF_DFSPARSEBLOCK_H
+#define __SRC_DF_DFSPARSEBLOCK_H
+
+#include <src/df/dfblock.h>
+#include <src/molecule/shellpair.h>
+
+namespace bagel {
+
+/*
+    DFSparseBlock is a slice of 3-index AO integrals (D|rs) in which only significant shell pairs (r <= s) are kept.
+    Each pair is a dense asize x nr x ns block with the aux index running fastest; (D|sr) is obtained by symmetry.
+*/
+
+class DFSparseBlock {
+  public:
+    struct PairBlock {
+      int offset0, size0;   // basis functions of r
+      int offset1, size1;   // basis functions of s
+      size_t pos;           // position in data_
+    };
+
+  protected:
+    std::shared_ptr<const StaticDist> adist_shell_;
+    size_t asize_;
+    size_t astart_;
+    size_t nbasis_;
+
+    std::vector<PairBlock> pairs_;
+    size_t size_;
+    std::unique_ptr<double[]> data_;
+
+  public:
+    DFSparseBlock(std::shared_ptr<const StaticDist> adist_shell, const size_t asize, const size_t astart, const size_t nbasis,
+                  const std::vector<std::shared_ptr<const ShellPair>>& pairs);
+
+    size_t asize() const { return asize_; }
+    size_t astart() const { return astart_; }
+    size_t nbasis() const { return nbasis_; }
+    size_t size() const { return size_; }
+
+    int npairs() const { return pairs_.size(); }
+    const PairBlock& pair(const int i) const { return pairs_[i]; }
+    double* data(const int i) { return data_.get() + pairs_[i].pos; }
+    const double* data(const int i) const { return data_.get() + pairs_[i].pos; }
+
+    const std::shared_ptr<const StaticDist>& adist_now() const { return adist_shell_; }
+
+    // the same as the DFBlock counterparts; the results are dense
+    std::shared_ptr<DFBlock> transform_second(const MatView c) const;
+    std::shared_ptr<VectorB> form_vec(const std::shared_ptr<const Matrix> den) const;
+    std::shared_ptr<Matrix> form_mat(const btas::Tensor1<double>& fit) const;
+    std::shared_ptr<Matrix> form_2index(const std::shared_ptr<const DFBlock> o, const double a) const;
+};
+
+}
+
+#endif
@@ -36,6 +36,9 @@ ParallelDF::ParallelDF(const size_t naux, const size_t nb1, const size_t nb2, sh
 
 
 shared_ptr<Matrix> ParallelDF::form_2index(shared_ptr<const ParallelDF> o, const double a, const bool swap) const {
+  // o may hold sparse or single-precision integrals, which only it knows how to contract
+  if (block_.size() == 1 && o->block_.empty())
+    return o->form_2index(shared_from_this(), a, !swap);
   if (block_.size() != 1 || o->block_.size() != 1) throw logic_error("so far assumes block_.size() == 1");
   shared_ptr<Matrix> out = (!swap) ? block_[0]->form_2index(o->block_[0], a) : o->block_[0]->form_2index(block_[0], a);
   if (!serial_)
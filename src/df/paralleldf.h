@@ -62,14 +62,21 @@ class ParallelDF : public std::enable_shared_from_this<ParallelDF> {
 
     std::vector<std::shared_ptr<DFBlock>>& block() { return block_; }
     const std::vector<std::shared_ptr<DFBlock>>& block() const { return block_; }
-    std::shared_ptr<DFBlock> block(const size_t i) { return block_[i]; }
-    std::shared_ptr<const DFBlock> block(const size_t i) const { return block_[i]; }
+    // block_ is empty when a DFDist stores its integrals in the sparse or single-precision format
+    std::shared_ptr<DFBlock> block(const size_t i) {
+      if (i >= block_.size()) throw std::logic_error("ParallelDF::block: dense 3-index block is not available (sparse or single-precision storage?)");
+      return block_[i];
+    }
+    std::shared_ptr<const DFBlock> block(const size_t i) const {
+      if (i >= block_.size()) throw std::logic_error("ParallelDF::block: dense 3-index block is not available (sparse or single-precision storage?)");
+      return block_[i];
+    }
 
-    std::shared_ptr<const StaticDist> adist_now() const { return block_[0]->adist_now(); }
+    virtual std::shared_ptr<const StaticDist> adist_now() const { return block(0)->adist_now(); }
 
     void add_block(std::shared_ptr<DFBlock> o);
 
-    std::shared_ptr<Matrix> form_2index(std::shared_ptr<const ParallelDF> o, const double a, const bool swap = false) const;
+    virtual std::shared_ptr<Matrix> form_2index(std::shared_ptr<const ParallelDF> o, const double a, const bool swap = false) const;
     std::shared_ptr<Matrix> form_4index(std::shared_ptr<const ParallelDF> o, const double a, const bool swap = false) const;
     std::shared_ptr<Matrix> form_aux_2index(std::shared_ptr<const ParallelDF> o, const double a) const;
 
@@ -89,8 +96,8 @@ class ParallelDF : public std::enable_shared_from_this<ParallelDF> {
     // compute a J operator, given density matrices in AO basis
     std::shared_ptr<Matrix> compute_Jop(const std::shared_ptr<const Matrix> den) const;
     std::shared_ptr<Matrix> compute_Jop(const std::shared_ptr<const ParallelDF> o, const std::shared_ptr<const Matrix> den, const bool onlyonce = false) const;
-    std::shared_ptr<Matrix> compute_Jop_from_cd(std::shared_ptr<const VectorB> cd) const;
-    std::shared_ptr<VectorB> compute_cd(const std::shared_ptr<const Matrix> den, std::shared_ptr<const Matrix> dat2 = nullptr, const int number_of_j = 2) const;
+    virtual std::shared_ptr<Matrix> compute_Jop_from_cd(std::shared_ptr<const VectorB> cd) const;
+    virtual std::shared_ptr<VectorB> compute_cd(const std::shared_ptr<const Matrix> den, std::shared_ptr<const Matrix> dat2 = nullptr, const int number_of_j = 2) const;
 
     void average_3index() {
       Timer time;
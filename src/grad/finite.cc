@@ -25,6 +25,7 @@
 #include <src/grad/gradeval.h>
 #include <src/grad/finite.h>
 #include <src/util/timer.h>
+#include <src/util/parallel/counter.h>
 #include <src/wfn/get_energy.h>
 
 using namespace std;
@@ -48,53 +49,59 @@ shared_ptr<GradFile> FiniteGrad::compute() {
   const int ncomm = mpi__->world_size() / nproc_;
   const int icomm = mpi__->world_rank() / nproc_;
 
+  // displacements are handed out to the process groups one at a time
+  Counter next_displ;
   mpi__->split(nproc_);
 
-  for (int i = 0, counter = 0; i != natom; ++i) {    // atom i
-    for (int j = 0; j != 3; ++j, ++counter) {      // xyz
-      if (counter % ncomm == icomm && ncomm != icomm) {
-        muffle_->mute();
-
-        double energy_plus = 0.0;
-        {
-          auto displ = make_shared<XYZFile>(natom);
-          displ->element(j,i) = dx_;
-          auto geom_plus = make_shared<Geometry>(*geom_, displ, make_shared<PTree>(), false, false);
-          geom_plus->print_atoms();
-
-          shared_ptr<const Reference> ref_plus;
-          if (ref_)
-            ref_plus = ref_->project_coeff(geom_plus);
-
-          for (auto& m : *idata_) {
-            const string title = to_lower(m->get<string>("title", ""));
-            tie(energy_plus, ref_plus) = get_energy(title, m, geom_plus, ref_plus, target_state_);
-          }
+  if (ncomm != icomm) {
+    while (true) {
+      size_t counter = mpi__->rank() == 0 ? next_displ.next() : 0;
+      mpi__->broadcast(&counter, 1, 0);
+      if (counter >= natom*3) break;
+      const int i = counter / 3; // atom i
+      const int j = counter % 3; // xyz
+
+      muffle_->mute();
+
+      double energy_plus = 0.0;
+      {
+        auto displ = make_shared<XYZFile>(natom);
+        displ->element(j,i) = dx_;
+        auto geom_plus = make_shared<Geometry>(*geom_, displ, make_shared<PTree>(), false, false);
+        geom_plus->print_atoms();
+
+        shared_ptr<const Reference> ref_plus;
+        if (ref_)
+          ref_plus = ref_->project_coeff(geom_plus);
+
+        for (auto& m : *idata_) {
+          const string title = to_lower(m->get<string>("title", ""));
+          tie(energy_plus, ref_plus) = get_energy(title, m, geom_plus, ref_plus, target_state_);
         }
+      }
 
-        double energy_minus = 0.0;
-        {
-          auto displ = make_shared<XYZFile>(natom);
-          displ->element(j,i) = -dx_;
-          auto geom_minus = make_shared<Geometry>(*geom_, displ, make_shared<PTree>(), false, false);
-          geom_minus->print_atoms();
+      double energy_minus = 0.0;
+      {
+        auto displ = make_shared<XYZFile>(natom);
+        displ->element(j,i) = -dx_;
+        auto geom_minus = make_shared<Geometry>(*geom_, displ, make_shared<PTree>(), false, false);
+        geom_minus->print_atoms();
 
-          shared_ptr<const Reference> ref_minus;
-          if (ref_)
-            ref_minus = ref_->project_coeff(geom_minus);
+        shared_ptr<const Reference> ref_minus;
+        if (ref_)
+          ref_minus = ref_->project_coeff(geom_minus);
 
-          for (auto& m : *idata_) {
-            const string title = to_lower(m->get<string>("title", ""));
-            tie(energy_minus, ref_minus) = get_energy(title, m, geom_minus, ref_minus, target_state_);
-          }
+        for (auto& m : *idata_) {
+          const string title = to_lower(m->get<string>("title", ""));
+          tie(energy_minus, ref_minus) = get_energy(title, m, geom_minus, ref_minus, target_state_);
         }
-
-        if (mpi__->rank() == 0)
-          grad->element(j,i) = (energy_plus - energy_minus) / (2.0 * dx_);
-        muffle_->unmute();
-        stringstream ss; ss << "Finite difference evaluation (" << setw(2) << i*3+j+1 << " / " << geom_->natom() * 3 << ")";
-        timer.tick_print(ss.str());
       }
+
+      if (mpi__->rank() == 0)
+        grad->element(j,i) = (energy_plus - energy_minus) / (2.0 * dx_);
+      muffle_->unmute();
+      stringstream ss; ss << "Finite difference evaluation (" << setw(2) << i*3+j+1 << " / " << geom_->natom() * 3 << ")";
+      timer.tick_print(ss.str());
     }
   }
   mpi__->merge();
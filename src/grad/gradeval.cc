@@ -126,6 +126,9 @@ shared_ptr<GradFile> GradEval<ROHF>::compute(const std::string jobtitle, shared_
 
 template<>
 shared_ptr<GradFile> GradEval<KS>::compute(const std::string jobtitle, shared_ptr<const GradInfo> gradinfo) {
+  // the derivative of the erf-attenuated exchange is not implemented
+  if (task_->func()->omega() != 0.0)
+    throw runtime_error("Nuclear gradients with range-separated functionals are not implemented");
   Timer timer;
 
   //- One ELECTRON PART -//
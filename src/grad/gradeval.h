@@ -56,6 +56,7 @@ class GradEval : public GradEval_base {
     void init() {
       if (geom_->external())
         throw std::logic_error("Gradients with external fields have not been implemented.");
+      geom_->require_dense_df("Nuclear gradient");
       auto idata_out = std::make_shared<PTree>(*idata_);
       task_ = std::make_shared<T>(idata_out, geom_, ref_);
       task_->compute();
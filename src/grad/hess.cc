@@ -23,6 +23,8 @@
 //
 
 #include <string>
+#include <cstdio>
+#include <fstream>
 #include <src/grad/hess.h>
 #include <src/grad/force.h>
 #include <src/grad/finite.h>
@@ -31,6 +33,10 @@
 #include <src/util/atommap.h>
 #include <src/util/constants.h>
 #include <src/util/timer.h>
+#include <src/util/archive.h>
+#include <src/util/hash.h>
+#include <src/util/serialization.h>
+#include <src/util/parallel/counter.h>
 #include <src/prop/multipole.h>
 
 using namespace std;
@@ -38,6 +44,25 @@ using namespace bagel;
 
 static const AtomMap atommap;
 
+// keys that do not affect the results are skipped
+static void hash_input(Hash& hash, shared_ptr<const PTree> tree, const bool top = false) {
+  for (auto& i : *tree) {
+    if (top && (i->key() == "nproc" || i->key() == "checkpoint"))
+      continue;
+    hash.add(i->key());
+    hash.add(i->data());
+    hash_input(hash, i);
+  }
+}
+
+static vector<double> positions(shared_ptr<const Geometry> geom) {
+  vector<double> out;
+  for (auto& atom : geom->atoms())
+    for (int l = 0; l != 3; ++l)
+      out.push_back(atom->position(l));
+  return out;
+}
+
 Hess::Hess(shared_ptr<const PTree> idata, shared_ptr<const Geometry> g, shared_ptr<const Reference> r) : idata_(idata), geom_(g), ref_(r) {
   numhess_ = idata_->get<bool>("numhess", true);
   numforce_ = idata_->get<bool>("numforce", false);
@@ -67,6 +92,15 @@ Hess::Hess(shared_ptr<const PTree> idata, shared_ptr<const Geometry> g, shared_p
   cout << "  Finite difference displacement (dx) is " << setprecision(8) << dx_ << " bohr" << endl;
 
   nproc_ = idata_->get<int>("nproc", 1);
+  checkpoint_ = idata_->get<bool>("checkpoint", true);
+  {
+    // idata_ contains the method blocks; the basis sets may be given in the molecule block instead
+    Hash hash;
+    hash_input(hash, idata_, true);
+    hash.add(geom_->basisfile());
+    hash.add(geom_->auxfile());
+    checkpoint_key_ = hash.hash();
+  }
 
   const int natom = geom_->natom();
   const int ndispl = natom * 3;
@@ -149,67 +183,38 @@ void Hess::compute() {
 
 void Hess::compute_finite_diff_() {
   Timer timer;
-  const int natom = geom_->natom();
+  const int ndispl = geom_->natom() * 3;
+
+  // displacements that are found in the checkpoint files are not recomputed
+  vector<size_t> todo;
+  if (mpi__->rank() == 0)
+    for (int counter = 0; counter != ndispl; ++counter)
+      if (!checkpoint_ || !read_checkpoint_(counter))
+        todo.push_back(counter);
+  size_t ntodo = todo.size();
+  mpi__->broadcast(&ntodo, 1, 0);
+  todo.resize(ntodo);
+  if (ntodo)
+    mpi__->broadcast(todo.data(), ntodo, 0);
+  if (ntodo != ndispl)
+    cout << "  " << ndispl - ntodo << " displacements have been read from the checkpoint files" << endl;
 
   const int ncomm = mpi__->world_size() / nproc_;
   const int icomm = mpi__->world_rank() / nproc_;
 
+  // displacements are handed out to the process groups one at a time
+  Counter next_displ;
   mpi__->split(nproc_);
 
-  for (int i = 0, counter = 0; i != natom; ++i) {  // atom i
-    for (int j = 0; j != 3; ++j, ++counter) { //xyz
-      if (counter % ncomm == icomm && ncomm != icomm) {
-        muffle_->mute();
-
-        vector<double> dipole_plus;
-        shared_ptr<const GradFile> outplus;
-        //displace +dx
-        {
-          auto displ = make_shared<XYZFile>(natom);
-          displ->element(j,i) = dx_;
-          auto geom_plus = make_shared<Geometry>(*geom_, displ, make_shared<PTree>(), false, false);
-          geom_plus->print_atoms();
-
-          shared_ptr<const Reference> ref_plus;
-          if (ref_)
-            ref_plus = ref_->project_coeff(geom_plus);
-
-          auto plus = make_shared<Force>(idata_, geom_plus, ref_plus);
-          outplus = plus->compute();
-          dipole_plus = plus->force_dipole();
-        }
-
-        // displace -dx
-        vector<double> dipole_minus;
-        shared_ptr<const GradFile> outminus;
-        {
-          auto displ = make_shared<XYZFile>(natom);
-          displ->element(j,i) = -dx_;
-          auto geom_minus = make_shared<Geometry>(*geom_, displ, make_shared<PTree>(), false, false);
-          geom_minus->print_atoms();
-
-          shared_ptr<const Reference> ref_minus;
-          if (ref_)
-            ref_minus = ref_->project_coeff(geom_minus);
-
-          auto minus = make_shared<Force>(idata_, geom_minus, ref_minus);
-          outminus = minus->compute();
-          dipole_minus = minus->force_dipole();
-        }
-
-        if (mpi__->rank() == 0) {
-          for (int k = 0, step = 0; k != natom; ++k) { // atom j
-            for (int l = 0; l != 3; ++l, ++step) { //xyz
-              (*hess_)(counter,step) = (outplus->element(l,k) - outminus->element(l,k)) / (2*dx_);
-              (*mw_hess_)(counter,step) =  (*hess_)(counter,step) / sqrt(geom_->atoms(i)->mass() * geom_->atoms(k)->mass());
-              (*cartesian_)(l,counter) = (dipole_plus[l] - dipole_minus[l]) / (2*dx_);
-            }
-          }
-        }
-        muffle_->unmute();
-        stringstream ss; ss << "Hessian evaluation (" << setw(2) << i*3+j+1 << " / " << natom * 3 << ")";
-        timer.tick_print(ss.str());
-      }
+  if (ncomm != icomm) {
+    while (true) {
+      size_t n = mpi__->rank() == 0 ? next_displ.next() : 0;
+      mpi__->broadcast(&n, 1, 0);
+      if (n >= ntodo) break;
+
+      compute_displacement_(todo[n]);
+      stringstream ss; ss << "Hessian evaluation (" << setw(2) << todo[n]+1 << " / " << ndispl << ")";
+      timer.tick_print(ss.str());
     }
   }
   mpi__->merge();
@@ -217,6 +222,133 @@ void Hess::compute_finite_diff_() {
   hess_->allreduce();
   mw_hess_->allreduce();
   cartesian_->allreduce();
+
+  if (checkpoint_ && mpi__->rank() == 0)
+    for (int counter = 0; counter != ndispl; ++counter)
+      remove((checkpoint_name_(counter) + ".archive").c_str());
+}
+
+
+void Hess::compute_displacement_(const int counter) {
+  const int natom = geom_->natom();
+  const int i = counter / 3;
+  const int j = counter % 3;
+
+  muffle_->mute();
+
+  // the undisplaced reference is projected to the displaced geometries and used as the starting guess
+  vector<double> dipole_plus;
+  shared_ptr<const GradFile> outplus;
+  //displace +dx
+  {
+    auto displ = make_shared<XYZFile>(natom);
+    displ->element(j,i) = dx_;
+    auto geom_plus = make_shared<Geometry>(*geom_, displ, make_shared<PTree>(), false, false);
+    geom_plus->print_atoms();
+
+    shared_ptr<const Reference> ref_plus;
+    if (ref_)
+      ref_plus = ref_->project_coeff(geom_plus);
+
+    auto plus = make_shared<Force>(idata_, geom_plus, ref_plus);
+    outplus = plus->compute();
+    dipole_plus = plus->force_dipole();
+  }
+
+  // displace -dx
+  vector<double> dipole_minus;
+  shared_ptr<const GradFile> outminus;
+  {
+    auto displ = make_shared<XYZFile>(natom);
+    displ->element(j,i) = -dx_;
+    auto geom_minus = make_shared<Geometry>(*geom_, displ, make_shared<PTree>(), false, false);
+    geom_minus->print_atoms();
+
+    shared_ptr<const Reference> ref_minus;
+    if (ref_)
+      ref_minus = ref_->project_coeff(geom_minus);
+
+    auto minus = make_shared<Force>(idata_, geom_minus, ref_minus);
+    outminus = minus->compute();
+    dipole_minus = minus->force_dipole();
+  }
+
+  if (mpi__->rank() == 0) {
+    for (int k = 0, step = 0; k != natom; ++k) { // atom j
+      for (int l = 0; l != 3; ++l, ++step) { //xyz
+        (*hess_)(counter,step) = (outplus->element(l,k) - outminus->element(l,k)) / (2*dx_);
+        (*mw_hess_)(counter,step) =  (*hess_)(counter,step) / sqrt(geom_->atoms(i)->mass() * geom_->atoms(k)->mass());
+        (*cartesian_)(l,counter) = (dipole_plus[l] - dipole_minus[l]) / (2*dx_);
+      }
+    }
+    if (checkpoint_)
+      write_checkpoint_(counter);
+  }
+  muffle_->unmute();
+}
+
+
+string Hess::checkpoint_name_(const int counter) const {
+  stringstream ss; ss << "hess_" << counter;
+  return ss.str();
+}
+
+
+// only called on process 0 of a process group
+void Hess::write_checkpoint_(const int counter) const {
+  const int ndispl = geom_->natom() * 3;
+  const vector<double> position = positions(geom_);
+  vector<double> hess(ndispl), dipole(3);
+  for (int step = 0; step != ndispl; ++step)
+    hess[step] = (*hess_)(counter, step);
+  for (int l = 0; l != 3; ++l)
+    dipole[l] = (*cartesian_)(l, counter);
+
+  // the archive is renamed after it is closed so that an interrupted write is never read back
+  const string name = checkpoint_name_(counter);
+  {
+    OArchive archive(name + "_tmp");
+    archive << checkpoint_key_ << position << dx_ << hess << dipole;
+  }
+  rename((name + "_tmp.archive").c_str(), (name + ".archive").c_str());
+}
+
+
+bool Hess::read_checkpoint_(const int counter) {
+  const string name = checkpoint_name_(counter);
+  if (!ifstream(name + ".archive").good())
+    return false;
+
+  const int ndispl = geom_->natom() * 3;
+  uint64_t key;
+  vector<double> position, hess, dipole;
+  double dx;
+  {
+    IArchive archive(name);
+    archive >> key;
+    if (key != checkpoint_key_) {
+      cout << "  * " << name << ".archive was written for a different input and is not used" << endl;
+      return false;
+    }
+    archive >> position >> dx >> hess >> dipole;
+  }
+
+  // checkpoints of other geometries or step sizes are ignored
+  const vector<double> current = positions(geom_);
+  if (position.size() != current.size() || !equal(position.begin(), position.end(), current.begin(), [](const double a, const double b) { return fabs(a-b) < 1.0e-10; })
+      || fabs(dx - dx_) > 1.0e-12 || hess.size() != ndispl || dipole.size() != 3)
+    return false;
+
+  const int i = counter / 3;
+  for (int k = 0, step = 0; k != geom_->natom(); ++k) {
+    for (int l = 0; l != 3; ++l, ++step) {
+      (*hess_)(counter,step) = hess[step];
+      (*mw_hess_)(counter,step) = hess[step] / sqrt(geom_->atoms(i)->mass() * geom_->atoms(k)->mass());
+    }
+  }
+  for (int l = 0; l != 3; ++l)
+    (*cartesian_)(l,counter) = dipole[l];
+  return true;
 }
 
 
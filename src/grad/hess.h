@@ -54,10 +54,19 @@ class Hess {
     double dx_;
     double energy_;
 
+    // finished displacements are written to "hess_<n>.archive" and read back when the calculation is restarted
+    bool checkpoint_;
+    // identifies the input (method blocks, basis sets, step) for which the checkpoint files were written
+    uint64_t checkpoint_key_;
+
     // mask some of the output
     mutable std::shared_ptr<Muffle> muffle_;
 
     void compute_finite_diff_();
+    void compute_displacement_(const int counter);
+    std::string checkpoint_name_(const int counter) const;
+    bool read_checkpoint_(const int counter);
+    void write_checkpoint_(const int counter) const;
     void project_zero_freq_();
     void print_ir_() const;
 
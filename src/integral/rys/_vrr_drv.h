@@ -31,11 +31,24 @@
 #include <numeric>
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <src/integral/rys/int2d.h>
 #include <src/integral/rys/scaledata.h>
 
+// number of primitive quartets that are processed together in vrr_driver_batch.
+// It follows the SIMD width of the target (-mavx512f or -mavx2) unless VRR_LANES is given explicitly.
+#ifndef VRR_LANES
+#  if defined(__AVX512F__)
+#    define VRR_LANES 8
+#  else
+#    define VRR_LANES 4
+#  endif
+#endif
+
 namespace bagel {
 
+constexpr int vrr_lanes__ = VRR_LANES;
+
 template<int a_, int b_, int c_, int d_, int rank_, typename DataType>
 void vrr_driver(DataType* out, const DataType* const roots, const DataType* const weights, const DataType& coeff,
                 const std::array<double,3>& A, const std::array<double,3>& B, const std::array<double,3>& C, const std::array<double,3>& D,
@@ -93,5 +106,90 @@ void vrr_driver(DataType* out, const DataType* const roots, const DataType* cons
 }
 
 
+// Processes up to vrr_lanes__ primitive quartets (index[0..nlane)) per call. The per-quartet quantities are gathered into
+// lane arrays ([root][lane]) so that the recursion and the sum over roots are vectorized across the quartets.
+// Work areas have to be vrr_lanes__ times larger than those for vrr_driver.
+template<int a_, int b_, int c_, int d_, int rank_, typename DataType>
+void vrr_driver_batch(DataType* out, const int& acsize, const int* const index, const int& nlane,
+                      const DataType* const roots, const DataType* const weights, const DataType* const coeff,
+                      const std::array<double,3>& A, const std::array<double,3>& B, const std::array<double,3>& C, const std::array<double,3>& D,
+                      const DataType* const P, const DataType* const Q, const double* const xp, const double* const xq,
+                      const int* const amap, const int* const cmap, const int& asize_, DataType* const workx, DataType* const worky, DataType* const workz) {
+  assert(nlane > 0 && nlane <= vrr_lanes__);
+
+  // compile time
+  constexpr int lanes_ = vrr_lanes__;
+  constexpr int lrank_ = rank_ * lanes_;
+  constexpr int amax_ = a_+b_;
+  constexpr int cmax_ = c_+d_;
+  constexpr int amax1_ = a_+b_+1;
+  constexpr int cmax1_ = c_+d_+1;
+  constexpr int amin_ = a_;
+  constexpr int cmin_ = c_;
+
+  constexpr int isize = (amax_ + 1) * (cmax_ + 1);
+  constexpr int worksize = lrank_ * isize;
+
+  // gather into lane arrays; unused lanes repeat the first quartet and are not written back
+  alignas(64) DataType lroots[lrank_];
+  alignas(64) DataType lweights[lrank_];
+  alignas(64) DataType lp[3][lanes_];
+  alignas(64) DataType lq[3][lanes_];
+  alignas(64) double lxp[lanes_];
+  alignas(64) double lxq[lanes_];
+  for (int l = 0; l != lanes_; ++l) {
+    const int ii = index[l < nlane ? l : 0];
+    for (int i = 0; i != rank_; ++i) {
+      lroots[i*lanes_+l] = roots[ii*rank_+i];
+      lweights[i*lanes_+l] = weights[ii*rank_+i] * coeff[ii];
+    }
+    for (int k = 0; k != 3; ++k) {
+      lp[k][l] = P[ii*3+k];
+      lq[k][l] = Q[ii*3+k];
+    }
+    lxp[l] = xp[ii];
+    lxq[l] = xq[ii];
+  }
+
+  int2d_batch<amax_,cmax_,rank_,lanes_, DataType>(lp[0], lq[0], A[0], C[0], lxp, lxq, lroots, workx);
+  scaledata<lrank_, worksize, DataType>(workx, lweights, 1.0, workx);
+
+  int2d_batch<amax_,cmax_,rank_,lanes_, DataType>(lp[1], lq[1], A[1], C[1], lxp, lxq, lroots, worky);
+  int2d_batch<amax_,cmax_,rank_,lanes_, DataType>(lp[2], lq[2], A[2], C[2], lxp, lxq, lroots, workz);
+
+  alignas(64) DataType iyiz[lrank_];
+  alignas(64) DataType sum[lanes_];
+
+  for (int iz = 0; iz <= cmax_; ++iz) {
+    for (int iy = 0; iy <= cmax_ - iz; ++iy) {
+      const int iyz = cmax1_ * (iy + cmax1_ * iz);
+      for (int jz = 0; jz <= amax_; ++jz) {
+        const int offsetz = lrank_ * (amax1_ * iz + jz);
+        for (int jy = 0; jy <= amax_ - jz; ++jy) {
+          const int offsety = lrank_ * (amax1_ * iy + jy);
+          const int jyz = amax1_ * (jy + amax1_ * jz);
+          for (int i = 0; i != lrank_; ++i)
+            iyiz[i] = worky[offsety + i] * workz[offsetz + i];
+          for (int ix = std::max(0, cmin_ - iy - iz); ix <= cmax_ - iy - iz; ++ix) {
+            const int iposition = cmap[ix + iyz];
+            const int ipos_asize = iposition * asize_;
+            for (int jx = std::max(0, amin_ - jy - jz); jx <= amax_ - jy - jz; ++jx) {
+              const int offsetx = lrank_ * (amax1_ * ix + jx);
+              const int ijposition = amap[jx + jyz] + ipos_asize;
+              std::fill_n(sum, lanes_, static_cast<DataType>(0.0));
+              for (int i = 0; i != lrank_; i += lanes_)
+                for (int l = 0; l != lanes_; ++l)
+                  sum[l] += iyiz[i + l] * workx[offsetx + i + l];
+              for (int l = 0; l != nlane; ++l)
+                out[index[l]*acsize + ijposition] = sum[l];
+            }
+          }
+        }
+      }
+    }
+  }
+
+}
+
 }
 #endif
@@ -34,8 +34,16 @@ static const CarSphList carsphlist;
 static const HRRList hrr;
 
 void ERIBatch::compute() {
-  bool swapped = false;
+  compute_contracted();
+
+  double* const stack_save = stack_->get(size_alloc_);
+  bkup_ = stack_save;
+  transform_contracted(1, &AB_, &CD_, data_, bkup_);
+  stack_->release(size_alloc_, stack_save);
+}
 
+
+void ERIBatch::compute_contracted() {
   double* const stack_save = stack_->get(size_alloc_);
   bkup_ = stack_save;
   fill_n(data_, size_alloc_, 0.0);
@@ -67,15 +75,30 @@ void ERIBatch::compute() {
       basisinfo_[3]->contractions(), basisinfo_[3]->contraction_upper(), basisinfo_[3]->contraction_lower(), cont3size_);
   }
 
-  // HRR to indices 01
-  // data will be stored in bkup_: cont01{ cont23{ xyzf{ xyzab{ } } } }
-  if (basisinfo_[1]->angular_number() != 0) {
-    const int hrr_index = basisinfo_[0]->angular_number() * ANG_HRR_END + basisinfo_[1]->angular_number();
-    hrr.hrrfunc_call(hrr_index, contsize_ * csize_, data_, AB_, bkup_);
-  } else {
-    swapped = swapped != true;
-  }
+  stack_->release(size_alloc_, stack_save);
+}
+
+
+size_t ERIBatch::size_transform() const {
+  const int ang0 = basisinfo_[0]->angular_number();
+  const int ang1 = basisinfo_[1]->angular_number();
+  const int ang2 = basisinfo_[2]->angular_number();
+  const int ang3 = basisinfo_[3]->angular_number();
+  const size_t asize_final = (ang0 + 1) * (ang0 + 2) * (ang1 + 1) * (ang1 + 2) / 4;
+  const size_t csize_final = (ang2 + 1) * (ang2 + 2) * (ang3 + 1) * (ang3 + 2) / 4;
+  const size_t asize_final_sph = spherical1_ ? (2 * ang0 + 1) * (2 * ang1 + 1) : asize_final;
+  return max(size_contracted(), max(asize_final * csize_ * contsize_, asize_final_sph * csize_final * contsize_));
+}
 
+
+// nbatch consecutive batches of contracted integrals (each of size_contracted()) in data are transformed into the final
+// form (each of data_size()), again in data. All the batches should be of the same class as this; only AB and CD differ.
+// work should be nbatch*size_transform() long, and so should data.
+void ERIBatch::transform_contracted(const int nbatch, const array<double,3>* ab, const array<double,3>* cd, double* data, double* work) const {
+  bool swapped = false;
+
+  // HRR to indices 01
+  // data will be stored in work: cont01{ cont23{ xyzf{ xyzab{ } } } }
   const int ang0 = basisinfo_[0]->angular_number();
   const int ang1 = basisinfo_[1]->angular_number();
   const int ang2 = basisinfo_[2]->angular_number();
@@ -90,111 +113,119 @@ void ERIBatch::compute() {
   const int csph = 2 * ang2 + 1;
   const int dsph = 2 * ang3 + 1;
 
+  if (ang1 != 0) {
+    const int hrr_index = ang0 * ANG_HRR_END + ang1;
+    const size_t nloop = contsize_ * csize_;
+    for (int i = 0; i != nbatch; ++i)
+      hrr.hrrfunc_call(hrr_index, nloop, data + i*nloop*asize_, ab[i], work + i*nloop*a*b);
+  } else {
+    swapped = swapped != true;
+  }
 
   // Cartesian to spherical 01 if necesarry
-  // data will be stored in data_
-  const bool need_sph01 = basisinfo_[0]->angular_number() > 1;
+  // data will be stored in data
+  const bool need_sph01 = ang0 > 1;
   if (spherical1_ && need_sph01) {
-    const int carsphindex = basisinfo_[0]->angular_number() * ANG_HRR_END + basisinfo_[1]->angular_number();
-    const int nloops = contsize_ * csize_;
+    const int carsphindex = ang0 * ANG_HRR_END + ang1;
+    const int nloops = contsize_ * csize_ * nbatch;
     if (!swapped)
-      carsphlist.carsphfunc_call(carsphindex, nloops, bkup_, data_);
+      carsphlist.carsphfunc_call(carsphindex, nloops, work, data);
     else
-      carsphlist.carsphfunc_call(carsphindex, nloops, data_, bkup_);
+      carsphlist.carsphfunc_call(carsphindex, nloops, data, work);
     swapped = swapped != true;
     a = asph;
     b = bsph;
   }
 
   // Transform batch for the second HRR step
-  // data will be stored in data_: cont01{ xyzab{ cont23{ xyzf{ } } } }  if cartesian
-  // data will be stored in bkup_: cont01{ xyzab{ cont23{ xyzf{ } } } }  if spherical
-  if (basisinfo_[0]->angular_number() != 0) {
+  // data will be stored in data: cont01{ xyzab{ cont23{ xyzf{ } } } }  if cartesian
+  // data will be stored in work: cont01{ xyzab{ cont23{ xyzf{ } } } }  if spherical
+  if (ang0 != 0) {
     const int m = a * b;
     const int n = cont2size_ * cont3size_ * csize_;
-    const int nloop = cont0size_ * cont1size_;
-    int offset = 0;
+    const int nloop = cont0size_ * cont1size_ * nbatch;
+    size_t offset = 0;
     if (swapped) {
       for (int i = 0; i != nloop; ++i, offset += m * n)
-        blas::transpose(&data_[offset], m, n, &bkup_[offset]);
+        blas::transpose(&data[offset], m, n, &work[offset]);
     } else {
       for (int i = 0; i != nloop; ++i, offset += m * n)
-        blas::transpose(&bkup_[offset], m, n, &data_[offset]);
+        blas::transpose(&work[offset], m, n, &data[offset]);
     }
   } else {
     swapped = swapped != true;
   }
 
   // HRR to indices 23
-  // data will be stored in bkup_: cont01{ xyzab{ cont23{ xyzcd{ } } } } if cartesian
-  // data will be stored in data_: cont01{ xyzab{ cont23{ xyzcd{ } } } } if spherical
-  if (basisinfo_[3]->angular_number() != 0) {
-    const int hrr_index = basisinfo_[2]->angular_number() * ANG_HRR_END + basisinfo_[3]->angular_number();
-    if (swapped) hrr.hrrfunc_call(hrr_index, contsize_ * a * b, bkup_, CD_, data_);
-    else         hrr.hrrfunc_call(hrr_index, contsize_ * a * b, data_, CD_, bkup_);
+  // data will be stored in work: cont01{ xyzab{ cont23{ xyzcd{ } } } } if cartesian
+  // data will be stored in data: cont01{ xyzab{ cont23{ xyzcd{ } } } } if spherical
+  if (ang3 != 0) {
+    const int hrr_index = ang2 * ANG_HRR_END + ang3;
+    const size_t nloop = contsize_ * a * b;
+    for (int i = 0; i != nbatch; ++i) {
+      if (swapped) hrr.hrrfunc_call(hrr_index, nloop, work + i*nloop*csize_, cd[i], data + i*nloop*c*d);
+      else         hrr.hrrfunc_call(hrr_index, nloop, data + i*nloop*csize_, cd[i], work + i*nloop*c*d);
+    }
   } else {
     swapped = swapped != true;
   }
 
   // Cartesian to spherical 23 if necesarry
-  // data will be stored in bkup_
-  const bool need_sph23 = basisinfo_[2]->angular_number() > 1;
+  // data will be stored in work
+  const bool need_sph23 = ang2 > 1;
   if (spherical2_ && need_sph23) {
-    const int carsphindex = basisinfo_[2]->angular_number() * ANG_HRR_END + basisinfo_[3]->angular_number();
-    const int nloops = contsize_ * asph * bsph;
+    const int carsphindex = ang2 * ANG_HRR_END + ang3;
+    const int nloops = contsize_ * asph * bsph * nbatch;
     if (swapped)
-      carsphlist.carsphfunc_call(carsphindex, nloops, data_, bkup_);
+      carsphlist.carsphfunc_call(carsphindex, nloops, data, work);
     else
-      carsphlist.carsphfunc_call(carsphindex, nloops, bkup_, data_);
+      carsphlist.carsphfunc_call(carsphindex, nloops, work, data);
     swapped = swapped != true;
     c = csph;
     d = dsph;
   }
 
-  // if swapped  bkup contains info
+  // if swapped  work contains info
   // if !swapped  data contains info
-  double *target_now = swapped ? bkup_ : data_;
-  double *source_now = swapped ? data_ : bkup_;
+  double *target_now = swapped ? work : data;
+  double *source_now = swapped ? data : work;
 
   // Sort cont23 and xyzcd
-  // data will be stored in data_: cont01{ xyzab{ cont3d{ cont2c{ } } } }
-  if (basisinfo_[2]->angular_number() != 0) {
+  // data will be stored in data: cont01{ xyzab{ cont3d{ cont2c{ } } } }
+  if (ang2 != 0) {
     const SortList sort2(spherical2_);
-    const int nloop = a * b * cont0size_ * cont1size_;
-    const unsigned int index = basisinfo_[3]->angular_number() * ANG_HRR_END + basisinfo_[2]->angular_number();
+    const int nloop = a * b * cont0size_ * cont1size_ * nbatch;
+    const unsigned int index = ang3 * ANG_HRR_END + ang2;
     sort2.sortfunc_call(index, target_now, source_now, cont3size_, cont2size_, nloop, swap23_);
   } else {
     swapped = swapped != true;
   }
 
-  target_now = swapped ? data_ : bkup_;
-  source_now = swapped ? bkup_ : data_;
+  target_now = swapped ? data : work;
+  source_now = swapped ? work : data;
   // transpose batch
-  // data will be stored in bkup_: cont3d{ cont2c{ cont01{ xyzab{ } } } }
+  // data will be stored in work: cont3d{ cont2c{ cont01{ xyzab{ } } } }
   if (!swap0123_) {
     const int m = c * d * cont2size_ * cont3size_;
     const int n = a * b * cont0size_ * cont1size_;
-    blas::transpose(source_now, m, n, target_now);
+    for (int i = 0; i != nbatch; ++i)
+      blas::transpose(source_now + i*m*n, m, n, target_now + i*m*n);
   } else {
     swapped = swapped != true;
   }
 
-  target_now = swapped ? bkup_ : data_;
-  source_now = swapped ? data_ : bkup_;
+  target_now = swapped ? work : data;
+  source_now = swapped ? data : work;
   // Sort cont01 and xyzab
-  // data will be stored in data_: cont3d{ cont2c{ cont1b{ cont0a{ } } } }
-  if (basisinfo_[0]->angular_number() != 0) {
+  // data will be stored in data: cont3d{ cont2c{ cont1b{ cont0a{ } } } }
+  if (ang0 != 0) {
     const SortList sort1(spherical1_);
-    const int nloop = c * d * cont2size_ * cont3size_;
-    const unsigned int index = basisinfo_[1]->angular_number() * ANG_HRR_END + basisinfo_[0]->angular_number();
+    const int nloop = c * d * cont2size_ * cont3size_ * nbatch;
+    const unsigned int index = ang1 * ANG_HRR_END + ang0;
     sort1.sortfunc_call(index, target_now, source_now, cont1size_, cont0size_, nloop, swap01_);
   } else {
     swapped = swapped != true;
   }
 
-  if (swapped) copy(bkup_, bkup_+size_alloc_, data_);
-
-  stack_->release(size_alloc_, stack_save);
+  if (swapped) copy_n(work, size_final_ * nbatch, data);
 }
-
-
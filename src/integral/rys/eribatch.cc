@@ -29,8 +29,8 @@
 using namespace std;
 using namespace bagel;
 
-ERIBatch::ERIBatch(const array<shared_ptr<const Shell>,4>& _info, const double max_density, const double dummy, const bool dum,
-                   shared_ptr<StackMem> stack) :  ERIBatch_base(_info, 0, 0, stack) {
+ERIBatch::ERIBatch(const array<shared_ptr<const Shell>,4>& _info, const double max_density, const double omega, const bool dum,
+                   shared_ptr<StackMem> stack) :  ERIBatch_base(_info, 0, 0, stack), omega_(omega) {
 
   const double integral_thresh = (max_density != 0.0) ? (PRIM_SCREEN_THRESH / max_density) : 0.0;
   compute_ssss(integral_thresh);
@@ -43,6 +43,20 @@ ERIBatch::ERIBatch(const array<shared_ptr<const Shell>,4>& _info, const double m
 }
 
 void ERIBatch::root_weight(const int ps) {
+  // The erf-attenuated integrals are those of the Coulomb operator evaluated at kappa*T, with the roots (t^2)
+  // scaled by kappa and the weights by sqrt(kappa), where kappa = omega^2/(omega^2 + rho).
+  vector<double> kappa;
+  if (omega_ != 0.0) {
+    kappa.resize(screening_size_);
+    const double omega2 = omega_ * omega_;
+    for (int j = 0; j != screening_size_; ++j) {
+      const int i = screening_[j];
+      const double rho = xp_[i] * xq_[i] / (xp_[i] + xq_[i]);
+      kappa[j] = omega2 / (omega2 + rho);
+      T_[i] *= kappa[j];
+    }
+  }
+
   if (amax_ + cmax_ == 0) {
     for (int j = 0; j != screening_size_; ++j) {
       int i = screening_[j];
@@ -57,5 +71,16 @@ void ERIBatch::root_weight(const int ps) {
   } else {
     eriroot__.root(rank_, T_, roots_, weights_, ps);
   }
+
+  if (omega_ != 0.0) {
+    for (int j = 0; j != screening_size_; ++j) {
+      const int i = screening_[j];
+      const double sqrtk = sqrt(kappa[j]);
+      for (int r = 0; r != rank_; ++r) {
+        roots_[i*rank_+r] *= kappa[j];
+        weights_[i*rank_+r] *= sqrtk;
+      }
+    }
+  }
 }
 
@@ -38,15 +38,28 @@ class ERIBatch : public ERIBatch_base {
     void perform_VRR3();
     void root_weight(const int ps) override;
 
+    // range-separation parameter of the erf(omega r)/r operator; zero means the Coulomb operator
+    const double omega_;
+
   public:
 
-    // dummy will never be used.
-    ERIBatch(const std::array<std::shared_ptr<const Shell>,4>&, const double max_density, const double dummy = 0.0, const bool dum = true,
+    ERIBatch(const std::array<std::shared_ptr<const Shell>,4>&, const double max_density, const double omega = 0.0, const bool dum = true,
              std::shared_ptr<StackMem> stack = nullptr);
 
     /// compute a batch of integrals
     void compute() override;
 
+    // the two halves of compute(), used by ERIClassBatch to process many quartets of the same class together:
+    // compute_contracted() leaves contracted integrals in data_ (size_contracted() elements), which
+    // transform_contracted() turns into the final integrals
+    void compute_contracted();
+    void transform_contracted(const int nbatch, const std::array<double,3>* ab, const std::array<double,3>* cd, double* data, double* work) const;
+    size_t size_contracted() const { return contsize_ * asize_ * csize_; }
+    size_t size_transform() const;
+
+    const std::array<double,3>& ab() const { return AB_; }
+    const std::array<double,3>& cd() const { return CD_; }
+
     constexpr static int Nblocks() { return 1; }
 };
 
@@ -0,0 +1,93 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: ericlassbatch.cc
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <src/integral/rys/ericlassbatch.h>
+
+using namespace std;
+using namespace bagel;
+
+ERIClassBatch::ERIClassBatch(const vector<array<shared_ptr<const Shell>,4>>& quartets, const vector<double>& max_density, const double omega,
+                             shared_ptr<StackMem> stack)
+ : quartets_(quartets), max_density_(max_density), omega_(omega) {
+  assert(!quartets_.empty() && quartets_.size() == max_density_.size());
+  assert(all_of(quartets_.begin(), quartets_.end(), [this](const array<shared_ptr<const Shell>,4>& q) { return same_class(q, quartets_.front()); }));
+
+  if (stack == nullptr) {
+    stack_ = resources__->get();
+    allocated_here_ = true;
+  } else {
+    stack_ = stack;
+    allocated_here_ = false;
+  }
+
+  first_ = make_shared<ERIBatch>(quartets_.front(), max_density_.front(), omega_, true, stack_);
+  size_block_ = first_->size_transform();
+  size_final_ = first_->data_size();
+
+  data_ = stack_->get(size_block_ * nbatch());
+  work_ = stack_->get(size_block_ * nbatch());
+}
+
+
+ERIClassBatch::~ERIClassBatch() {
+  stack_->release(size_block_ * nbatch(), work_);
+  stack_->release(size_block_ * nbatch(), data_);
+  first_.reset();
+
+  if (allocated_here_)
+    resources__->release(stack_);
+}
+
+
+bool ERIClassBatch::same_class(const array<shared_ptr<const Shell>,4>& a, const array<shared_ptr<const Shell>,4>& b) {
+  for (int i = 0; i != 4; ++i)
+    if (a[i]->angular_number() != b[i]->angular_number() || a[i]->num_contracted() != b[i]->num_contracted() || a[i]->spherical() != b[i]->spherical())
+      return false;
+  return true;
+}
+
+
+void ERIClassBatch::compute() {
+  // contracted integrals of each quartet, packed in data_
+  const size_t csize = first_->size_contracted();
+  vector<array<double,3>> ab(nbatch());
+  vector<array<double,3>> cd(nbatch());
+
+  first_->compute_contracted();
+  copy_n(first_->data(), csize, data_);
+  ab[0] = first_->ab();
+  cd[0] = first_->cd();
+
+  for (int i = 1; i != nbatch(); ++i) {
+    ERIBatch eri(quartets_[i], max_density_[i], omega_, true, stack_);
+    assert(eri.size_contracted() == csize);
+    eri.compute_contracted();
+    copy_n(eri.data(), csize, data_ + i*csize);
+    ab[i] = eri.ab();
+    cd[i] = eri.cd();
+  }
+
+  first_->transform_contracted(nbatch(), ab.data(), cd.data(), data_, work_);
+}
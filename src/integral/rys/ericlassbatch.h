@@ -0,0 +1,75 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: ericlassbatch.h
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef __SRC_INTEGRAL_RYS_ERICLASSBATCH_H
+#define __SRC_INTEGRAL_RYS_ERICLASSBATCH_H
+
+#include <src/integral/rys/eribatch.h>
+
+namespace bagel {
+
+// Evaluates a list of shell quartets of the same class (see same_class) in one go. Roots and VRR are computed quartet
+// by quartet, whereas HRR, Cartesian-to-spherical transformation and sorting run over the whole list. The integrals
+// of the i-th quartet are found at data(i), in the same order as ERIBatch::data().
+class ERIClassBatch {
+  protected:
+    std::vector<std::array<std::shared_ptr<const Shell>,4>> quartets_;
+    std::vector<double> max_density_;
+    const double omega_;
+
+    bool allocated_here_;
+    std::shared_ptr<StackMem> stack_;
+
+    // the first quartet is kept to carry the class information
+    std::shared_ptr<ERIBatch> first_;
+
+    size_t size_block_;
+    size_t size_final_;
+    double* data_;
+    double* work_;
+
+  public:
+    ERIClassBatch(const std::vector<std::array<std::shared_ptr<const Shell>,4>>& quartets, const std::vector<double>& max_density,
+                  const double omega = 0.0, std::shared_ptr<StackMem> stack = nullptr);
+    ERIClassBatch(const ERIClassBatch&) = delete;
+    ~ERIClassBatch();
+
+    void compute();
+
+    int nbatch() const { return quartets_.size(); }
+    const double* data(const int i) const { assert(i >= 0 && i < nbatch()); return data_ + i*size_final_; }
+    size_t data_size() const { return size_final_; }
+
+    // the largest number of quartets the direct Fock build puts in one ERIClassBatch (Molecule::stack_size() accounts for it)
+    static constexpr int max_nbatch() { return 64; }
+
+    // true when two quartets can be put in the same ERIClassBatch
+    static bool same_class(const std::array<std::shared_ptr<const Shell>,4>& a, const std::array<std::shared_ptr<const Shell>,4>& b);
+};
+
+}
+
+#endif
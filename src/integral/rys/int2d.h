@@ -62,6 +62,46 @@ void int2d(const DataType& P, const DataType& Q, const DataType& A, const DataTy
   vrr<a_,c_,rank_, DataType>(data, C00_, D00_, B00_, B01_, B10_);
 }
 
+// same as int2d for lanes_ primitive quartets at once; P, Q, xp and xq are lane arrays, roots and data are ordered as [root][lane].
+template <int a_, int c_, int rank_, int lanes_, typename DataType>
+void int2d_batch(const DataType* P, const DataType* Q, const DataType& A, const DataType& C,
+                 const double* xp, const double* xq, const DataType* roots, DataType* const data) {
+  constexpr int lrank_ = rank_ * lanes_;
+  alignas(64) DataType C00_[lrank_];
+  alignas(64) DataType D00_[lrank_];
+  alignas(64) DataType B00_[lrank_];
+  alignas(64) DataType B10_[lrank_];
+  alignas(64) DataType B01_[lrank_];
+
+  for (int l = 0; l != lanes_; ++l) {
+    const double one_pq = 1.0 / (xp[l] + xq[l]);
+    const double one_2p = 0.5 / xp[l];
+    const double one_2q = 0.5 / xq[l];
+    const double xqopq = xq[l] * one_pq;
+    const double xpopq = xp[l] * one_pq;
+
+    const DataType c00i0 = P[l] - A;
+    const DataType c00i1 = (P[l] - Q[l]) * xqopq;
+    const DataType d00i0 = Q[l] - C;
+    const DataType d00i1 = (P[l] - Q[l]) * xpopq;
+    const double b00i0 = 0.5 * one_pq;
+    const double b10i0 = xqopq * one_2p;
+    const double b01i0 = xpopq * one_2q;
+
+    for (int i = l; i < lrank_; i += lanes_) {
+      const DataType tsq = roots[i];
+      C00_[i] = c00i0 - c00i1 * tsq;
+      D00_[i] = d00i0 + d00i1 * tsq;
+      B00_[i] = b00i0 * tsq;
+      B10_[i] = one_2p - b10i0 * tsq;
+      B01_[i] = one_2q - b01i0 * tsq;
+    }
+  }
+
+  // the recursion is elementwise in the root index, so all lanes go through it as a single vector
+  vrr<a_,c_,lrank_, DataType>(data, C00_, D00_, B00_, B01_, B10_);
+}
+
 }
 
 #endif
@@ -0,0 +1,141 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: bench_vrr.cc
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// Standalone microbenchmark of the Rys VRR drivers (not part of the library build).
+// For each angular class, vrr_driver is called once per primitive quartet and vrr_driver_batch once per vrr_lanes__ quartets
+// on the same random data; the maximum deviation and the timings are printed. From the top source directory (after configure):
+//
+//   mpicxx -std=c++11 -O3 [-mavx2 | -mavx512f] -I. src/integral/rys/vrr_gen/bench_vrr.cc -o bench_vrr
+//   ./bench_vrr [number of primitive quartets] [repeat]
+//
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <cmath>
+#include <src/util/math/algo.h>
+#include <src/integral/rys/_vrr_drv.h>
+
+using namespace std;
+using namespace bagel;
+
+namespace {
+
+template<int a_, int b_, int c_, int d_>
+void bench(const int nprim, const int repeat) {
+  constexpr int rank_ = (a_+b_+c_+d_)/2 + 1;
+  constexpr int amin_ = a_;
+  constexpr int cmin_ = c_;
+  constexpr int amax_ = a_+b_;
+  constexpr int cmax_ = c_+d_;
+  constexpr int amax1_ = amax_+1;
+  constexpr int cmax1_ = cmax_+1;
+
+  // same ordering as RysIntegral::set_swap_info
+  vector<int> amap(amax1_*amax1_*amax1_);
+  vector<int> cmap(cmax1_*cmax1_*cmax1_);
+  int asize = 0;
+  for (int j = amin_; j <= amax_; ++j)
+    for (int jz = 0; jz <= j; ++jz)
+      for (int jy = 0; jy <= j - jz; ++jy)
+        amap[(j-jy-jz) + amax1_ * (jy + amax1_ * jz)] = asize++;
+  int csize = 0;
+  for (int i = cmin_; i <= cmax_; ++i)
+    for (int iz = 0; iz <= i; ++iz)
+      for (int iy = 0; iy <= i - iz; ++iy)
+        cmap[(i-iy-iz) + cmax1_ * (iy + cmax1_ * iz)] = csize++;
+  const int acsize = asize * csize;
+
+  mt19937 gen(11);
+  uniform_real_distribution<double> unit(0.0, 1.0);
+  const array<double,3> A{{0.0, 0.0, 0.0}}, B{{0.0, 1.2, 0.4}}, C{{1.5, -0.3, 0.8}}, D{{2.1, 0.5, -0.6}};
+  vector<double> roots(nprim*rank_), weights(nprim*rank_), coeff(nprim), P(nprim*3), Q(nprim*3), xp(nprim), xq(nprim);
+  for (int i = 0; i != nprim; ++i) {
+    const double ea = 0.1 + 5.0*unit(gen), eb = 0.1 + 5.0*unit(gen), ec = 0.1 + 5.0*unit(gen), ed = 0.1 + 5.0*unit(gen);
+    xp[i] = ea + eb;
+    xq[i] = ec + ed;
+    for (int k = 0; k != 3; ++k) {
+      P[i*3+k] = (ea*A[k] + eb*B[k]) / xp[i];
+      Q[i*3+k] = (ec*C[k] + ed*D[k]) / xq[i];
+    }
+    for (int r = 0; r != rank_; ++r) {
+      roots[i*rank_+r] = unit(gen);
+      weights[i*rank_+r] = unit(gen);
+    }
+    coeff[i] = unit(gen);
+  }
+  vector<int> index(nprim);
+  iota(index.begin(), index.end(), 0);
+
+  const int isize = amax1_ * cmax1_;
+  vector<double> work(isize*rank_*3*vrr_lanes__);
+  vector<double> ref(nprim*acsize), out(nprim*acsize);
+
+  auto t0 = chrono::high_resolution_clock::now();
+  for (int n = 0; n != repeat; ++n)
+    for (int i = 0; i != nprim; ++i)
+      vrr_driver<a_,b_,c_,d_,rank_,double>(ref.data()+i*acsize, roots.data()+i*rank_, weights.data()+i*rank_, coeff[i], A, B, C, D,
+                                           P.data()+i*3, Q.data()+i*3, xp[i], xq[i], amap.data(), cmap.data(), asize,
+                                           work.data(), work.data()+isize*rank_, work.data()+2*isize*rank_);
+  auto t1 = chrono::high_resolution_clock::now();
+  for (int n = 0; n != repeat; ++n)
+    for (int j = 0; j < nprim; j += vrr_lanes__)
+      vrr_driver_batch<a_,b_,c_,d_,rank_,double>(out.data(), acsize, index.data()+j, min(vrr_lanes__, nprim-j), roots.data(), weights.data(), coeff.data(),
+                                                 A, B, C, D, P.data(), Q.data(), xp.data(), xq.data(), amap.data(), cmap.data(), asize,
+                                                 work.data(), work.data()+isize*rank_*vrr_lanes__, work.data()+2*isize*rank_*vrr_lanes__);
+  auto t2 = chrono::high_resolution_clock::now();
+
+  double maxdiff = 0.0, maxval = 0.0;
+  for (size_t i = 0; i != ref.size(); ++i) {
+    maxdiff = max(maxdiff, fabs(ref[i] - out[i]));
+    maxval = max(maxval, fabs(ref[i]));
+  }
+  const double single = chrono::duration<double>(t1-t0).count();
+  const double batch = chrono::duration<double>(t2-t1).count();
+  printf("  (%d%d|%d%d) rank %d  %10.4f %10.4f  speedup %5.2f  max diff %8.2e (max %8.2e)\n",
+         a_, b_, c_, d_, rank_, single, batch, single/batch, maxdiff, maxval);
+}
+
+}
+
+
+int main(int argc, char** argv) {
+  const int nprim = argc > 1 ? atoi(argv[1]) : 1024;
+  const int repeat = argc > 2 ? atoi(argv[2]) : 200;
+  printf("  %d primitive quartets x %d, %d lanes\n", nprim, repeat, vrr_lanes__);
+  printf("  class         vrr_driver (s)  batch (s)\n");
+  bench<0,0,0,0>(nprim, repeat);
+  bench<1,0,1,0>(nprim, repeat);
+  bench<1,1,1,1>(nprim, repeat);
+  bench<2,0,2,0>(nprim, repeat);
+  bench<2,1,2,1>(nprim, repeat);
+  bench<2,2,2,2>(nprim, repeat);
+  bench<3,2,3,2>(nprim, repeat);
+  bench<3,3,3,3>(nprim, repeat);
+  bench<4,4,4,4>(nprim, repeat);
+  return 0;
+}
@@ -71,6 +71,7 @@ int main(int argc, char** argv) {
 
       const string title = to_lower(itree->get<string>("title", ""));
       if (title.empty()) throw runtime_error("title is missing in one of the input blocks");
+      Profile prof(title);
 
       if (title == "molecule") {
         geom = geom ? make_shared<Geometry>(*geom, itree) : make_shared<Geometry>(itree);
@@ -220,6 +221,10 @@ int main(int argc, char** argv) {
 
     }
 
+    // diagnostics of the integral scratch memory, printed with the profile (BAGEL_PROFILE)
+    if (Profiler::enabled())
+      resources__->print_stack_usage();
+    Profiler::write();
     print_footer();
 
   } catch (const Termination& e) {
@@ -22,11 +22,13 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <set>
 #include <src/molecule/molecule.h>
 #include <src/molecule/molecule_connect.h>
 #include <src/util/constants.h>
 #include <src/util/atommap.h>
 #include <src/util/math/quatern.h>
+#include <src/integral/rys/ericlassbatch.h>
 
 using namespace std;
 using namespace bagel;
@@ -277,6 +279,59 @@ void Molecule::common_init1() {
 }
 
 
+size_t Molecule::stack_size() const {
+  auto ncart = [](const int l) { return static_cast<size_t>((l+1)*(l+2)/2); };
+  // cartesian functions generated in the VRR for a shell pair, including the range needed for derivatives
+  auto nrange = [&ncart](const int l0, const int l1) {
+    size_t out = 0lu;
+    for (int l = std::max(l0-1, 0); l <= l0+l1+1; ++l)
+      out += ncart(l);
+    return out;
+  };
+
+  // the batch size factorizes into bra and ket pairs; primitive and final (gradient) sizes are bounded separately
+  // pairs of angular momentum and number of primitives
+  set<pair<int,int>> types, aux_types, contr_types;
+  for (auto& a : atoms_)
+    for (auto& s : a->shells()) {
+      types.emplace(s->angular_number(), s->num_primitive());
+      contr_types.emplace(s->angular_number(), s->num_contracted());
+    }
+  for (auto& a : aux_atoms_)
+    for (auto& s : a->shells())
+      aux_types.emplace(s->angular_number(), s->num_primitive());
+
+  size_t pair_prim = 1lu, pair_final = 1lu;
+  for (auto& s0 : types)
+    for (auto& s1 : types) {
+      const size_t nprim = s0.second * s1.second;
+      pair_prim = max(pair_prim, nrange(s0.first, s1.first) * nprim);
+      pair_final = max(pair_final, ncart(s0.first) * ncart(s1.first) * nprim);
+    }
+  size_t quartet = max(pair_prim*pair_prim, 12lu*pair_final*pair_final);
+
+  // three-index integrals with an auxiliary shell and a dummy shell on the bra
+  for (auto& s : aux_types) {
+    const size_t aux_prim = nrange(s.first, 0) * s.second;
+    const size_t aux_final = ncart(s.first) * s.second;
+    quartet = max(quartet, max(aux_prim*pair_prim, 12lu*aux_final*pair_final));
+  }
+
+  // direct Fock builds keep the contracted integrals of up to ERIClassBatch::max_nbatch() quartets, twice (data and work area)
+  size_t pair_contr = 1lu, pair_contr_range = 1lu;
+  for (auto& s0 : contr_types)
+    for (auto& s1 : contr_types) {
+      const size_t ncontr = s0.second * s1.second;
+      pair_contr = max(pair_contr, ncart(s0.first) * ncart(s1.first) * ncontr);
+      pair_contr_range = max(pair_contr_range, nrange(s0.first, s1.first) * ncontr);
+    }
+  const size_t classbatch = 2lu * ERIClassBatch::max_nbatch() * pair_contr * pair_contr_range;
+
+  // the batch itself, the work area of the same size in compute(), and the Rys roots, weights and the like, on top of the class buffers
+  return max(3lu*quartet + classbatch, 1000000lu);
+}
+
+
 void Molecule::merge_obs_aux() {
   aux_merged_ = true;
   atoms_.insert(atoms_.end(), aux_atoms_.begin(), aux_atoms_.end());
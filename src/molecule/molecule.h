@@ -108,7 +108,7 @@ class Molecule {
     const std::string basisfile() const { return basisfile_; }
     const std::string auxfile() const { return auxfile_; }
     virtual double nuclear_repulsion() const { return nuclear_repulsion_; }
-    bool skip_self_interaction() { return skip_self_interaction_; }
+    bool skip_self_interaction() const { return skip_self_interaction_; }
 
     // The position of the specific function in the basis set.
     const std::vector<std::vector<int>>& offsets() const { return offsets_; }
@@ -118,6 +118,9 @@ class Molecule {
 
     int num_count_ncore_only() const; // also set nfrc_
 
+    // number of doubles that integral batches of the largest shell quartet (including gradients) need on the stack
+    size_t stack_size() const;
+
     void print_atoms() const;
 
     bool operator==(const Molecule& o) const;
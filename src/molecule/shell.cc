@@ -302,6 +302,40 @@ void Shell::compute_grid_value(double* b, double* dx, double* dy, double* dz, co
 }
 
 
+double Shell::extent(const double thresh) const {
+  if (exponents_.empty())
+    return 0.0;
+  const int l = angular_number();
+  // rough upper bound of the contracted functions and their first and second derivatives at distance r
+  auto bound = [&](const double r) {
+    double out = 0.0;
+    auto range = contraction_ranges_.begin();
+    for (auto& i : contractions_) {
+      double sum = 0.0;
+      for (int j = range->first; j != range->second; ++j)
+        sum += fabs(i[j]) * pow(1.0 + (l ? l/r : 0.0) + 2.0*exponents_[j]*r, 2) * exp(-exponents_[j]*r*r);
+      out = max(out, sum);
+      ++range;
+    }
+    return out * pow(r, l);
+  };
+
+  // the bound decreases monotonically beyond the maxima of r^(l+2) exp(-a r^2)
+  const double amin = *min_element(exponents_.begin(), exponents_.end());
+  double lo = max(1.0, sqrt((l+2)/(2.0*amin)));
+  if (bound(lo) < thresh)
+    return lo;
+  double hi = 2.0*lo;
+  while (bound(hi) >= thresh)
+    hi *= 2.0;
+  for (int i = 0; i != 40; ++i) {
+    const double mid = 0.5*(lo+hi);
+    (bound(mid) < thresh ? hi : lo) = mid;
+  }
+  return hi;
+}
+
+
 // In DFT we want to compute values of basis functions on grid
 void Shell::compute_grid_value_deriv2(double* bxx, double* bxy, double* byy, double* bxz, double* byz, double* bzz,
                                       const double& x, const double& y, const double& z) const {
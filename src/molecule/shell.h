@@ -153,6 +153,8 @@ class Shell : public Shell_base {
     // DFT grid
     void compute_grid_value(double*, double*, double*, double*, const double& x, const double& y, const double& z) const;
     void compute_grid_value_deriv2(double*, double*, double*, double*, double*, double*, const double& x, const double& y, const double& z) const;
+    // distance from the center beyond which the functions and their gradients are smaller than thresh
+    double extent(const double thresh) const;
 
     std::shared_ptr<const Shell> uncontract() const;
 
@@ -39,6 +39,7 @@ template<>
 void GradEval<CASSCF>::init() {
   if (geom_->external())
     throw logic_error("Gradients with external fields have not been implemented.");
+  geom_->require_dense_df("Nuclear gradient");
   // target has to be passed to T (for CASPT2, for instance)
   auto idata_out = make_shared<PTree>(*idata_);
 
@@ -104,6 +104,8 @@ void CASSCF::common_init() {
   thresh_ = idata_->get<double>("thresh", 1.0e-8);
   // get thresh (for micro iteration) from the input
   thresh_micro_ = idata_->get<double>("thresh_micro", 5.0e-6);
+  // screening of the exchange build (0 means no screening)
+  thresh_exchange_ = idata_->get<double>("thresh_exchange", 0.0);
 
   // whether or not to throw if the calculation does not converge
   conv_ignore_ = idata_->get<bool>("conv_ignore", false);
@@ -221,7 +223,7 @@ std::shared_ptr<Matrix> CASSCF::compute_active_fock(const MatView acoeff, shared
   copy_n(rdm1->data(), nact_*nact_, dkl.data());
   dkl.sqrt();
   dkl.scale(1.0/sqrt(2.0));
-  return make_shared<Fock<1>>(geom_, hcore_->clone(), nullptr, acoeff * dkl, /*store*/false, /*rhf*/true);
+  return make_shared<Fock<1>>(geom_, hcore_->clone(), nullptr, acoeff * dkl, /*store*/false, /*rhf*/true, 1.0, 1.0, thresh_exchange_);
 }
 
 
@@ -239,9 +241,9 @@ shared_ptr<const Coeff> CASSCF::semi_canonical_orb() const {
   VectorB eig(coeff_->mdim());
   Fock<1> fock;
   if (nact_)
-    fock = Fock<1>(geom_, fci_->jop()->core_fock(), nullptr, acoeff * *rdm1mat, false, /*rhf*/true);
+    fock = Fock<1>(geom_, fci_->jop()->core_fock(), nullptr, acoeff * *rdm1mat, false, /*rhf*/true, 1.0, 1.0, thresh_exchange_);
   else
-    fock = Fock<1>(geom_, ref_->hcore(), nullptr, coeff_->slice_copy(0, nclosed_), false, /*rhf*/true);
+    fock = Fock<1>(geom_, ref_->hcore(), nullptr, coeff_->slice_copy(0, nclosed_), false, /*rhf*/true, 1.0, 1.0, thresh_exchange_);
 
   Matrix trans(nmo_, nmo_);
   trans.unit();
@@ -82,6 +82,8 @@ class CASSCF : public Method, public std::enable_shared_from_this<CASSCF> {
     double thresh_;
     double thresh_micro_;
     double thresh_overlap_;
+    // screening threshold for the DF exchange build with localized orbitals (0 means no screening)
+    double thresh_exchange_;
     bool conv_ignore_;
     bool restart_cas_;
     bool natocc_;
@@ -138,6 +140,7 @@ class CASSCF : public Method, public std::enable_shared_from_this<CASSCF> {
     double thresh() const { return thresh_; }
     double thresh_micro() const { return thresh_micro_; }
     double thresh_overlap() const { return thresh_overlap_; }
+    double thresh_exchange() const { return thresh_exchange_; }
 
     double energy(const int i) const { return energy_[i]; }
     double energy_av() const { return blas::average(energy_); }
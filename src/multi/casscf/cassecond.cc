@@ -228,17 +228,20 @@ shared_ptr<RotFile> CASSecond::compute_denom(shared_ptr<const DFHalfDist> half,
       for (int j = 0; j != nvirt_; ++j)
         denom->ele_va(j, i) += 2.0 * (*cfock)(j+nocc_, j+nocc_) * rdm1(i, i) - 2.0 * fcd(i, i);
 
-    const int nao = coeff_->ndim();
+    // (D|rs) v_D for the local part of v, summed over the processes
+    auto contract_ao = [this](const double* v, const size_t astart, const int nri) {
+      auto cd = make_shared<VectorB>(geom_->df()->naux());
+      copy_n(v, nri, cd->data()+astart);
+      return geom_->df()->compute_Jop_from_cd(cd);
+    };
     if (nclosed_) {
       auto vvc = half_1j->compute_second_transform(vcoeff)->form_4index_diagonal()->transpose();
       denom->ax_plus_y_vc(12.0, *vvc);
 
       shared_ptr<const DFFullDist> vgcc = half->compute_second_transform(ccoeff);
       const int nri = vgcc->block(0)->asize();
-      Matrix tmp(nao, nao);
       for (int i = 0; i != nclosed_; ++i) {
-        dgemv_("T", nri, nao*nao, 1.0, geom_->df()->block(0)->data(), nri, vgcc->block(0)->data()+nri*(i+nclosed_*i), 1, 0.0, tmp.data(), 1);
-        tmp.allreduce();
+        const Matrix tmp = *contract_ao(vgcc->block(0)->data()+nri*(i+nclosed_*i), vgcc->block(0)->astart(), nri);
         Matrix tmp0 = vcoeff % tmp * vcoeff;
         blas::ax_plus_y_n(-4.0, tmp0.diag().data(), nvirt_, denom->ptr_vc()+nvirt_*i);
       }
@@ -247,10 +250,8 @@ shared_ptr<RotFile> CASSecond::compute_denom(shared_ptr<const DFHalfDist> half,
     const int nri = vaa->block(0)->asize();
     {
       shared_ptr<const DFFullDist> vgaa = vaa->apply_2rdm(*fci_->rdm2_av());
-      Matrix tmp(nao, nao);
       for (int i = 0; i != nact_; ++i) {
-        dgemv_("T", nri, nao*nao, 1.0, geom_->df()->block(0)->data(), nri, vgaa->block(0)->data()+nri*(i+nact_*i), 1, 0.0, tmp.data(), 1);
-        tmp.allreduce();
+        const Matrix tmp = *contract_ao(vgaa->block(0)->data()+nri*(i+nact_*i), vgaa->block(0)->astart(), nri);
         Matrix tmp0 = vcoeff % tmp * vcoeff;
         blas::ax_plus_y_n(2.0, tmp0.diag().data(), nvirt_, denom->ptr_va()+nvirt_*i);
         if (nclosed_) {
@@ -286,13 +287,11 @@ shared_ptr<RotFile> CASSecond::compute_denom(shared_ptr<const DFHalfDist> half,
       }
     }
     if (nclosed_) {
-      Matrix tmp(nao, nao);
       shared_ptr<DFFullDist> vgaa = vaa->copy();
       vgaa = vgaa->transform_occ1(make_shared<Matrix>(rdm1));
       vgaa->ax_plus_y(-1.0, vaa);
       for (int i = 0; i != nact_; ++i) {
-        dgemv_("T", nri, nao*nao, 1.0, geom_->df()->block(0)->data(), nri, vgaa->block(0)->data()+nri*(i+nact_*i), 1, 0.0, tmp.data(), 1);
-        tmp.allreduce();
+        const Matrix tmp = *contract_ao(vgaa->block(0)->data()+nri*(i+nact_*i), vgaa->block(0)->astart(), nri);
         Matrix tmp0 = ccoeff % tmp * ccoeff;
         blas::ax_plus_y_n(4.0, tmp0.diag().data(), nclosed_, denom->ptr_ca()+nclosed_*i);
       }
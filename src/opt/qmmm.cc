@@ -182,3 +182,131 @@ tuple<double,shared_ptr<GradFile>> QMMM_Tinker::do_grad(const int natom) const {
   // return the energy and gradient
   return tie(mmen, out);
 }
+
+
+QMMM_Internal::QMMM_Internal(shared_ptr<const PTree> idata, shared_ptr<const Geometry> geom) {
+  // parameters are given in kcal/mol, angstrom and degree as in common force fields; atoms are numbered from 1
+  const double kcal = kcal2kj__ / au2kjmol__;
+  const int natom = geom->natom();
+  auto atom_index = [&natom](const int i) {
+    if (i < 1 || i > natom)
+      throw runtime_error("QM/MM: atom index out of range");
+    return i-1;
+  };
+
+  if (auto bonds = idata->get_child_optional("bonds")) {
+    for (auto& b : *bonds) {
+      array<int,2> atoms = b->get_array<int,2>("atoms");
+      for (auto& i : atoms) i = atom_index(i);
+      bonds_.emplace_back(atoms, b->get<double>("k") * kcal * au2angstrom__ * au2angstrom__, b->get<double>("r0") / au2angstrom__);
+      excluded_.insert(minmax(atoms[0], atoms[1]));
+    }
+  }
+  if (auto angles = idata->get_child_optional("angles")) {
+    for (auto& a : *angles) {
+      array<int,3> atoms = a->get_array<int,3>("atoms");
+      for (auto& i : atoms) i = atom_index(i);
+      angles_.emplace_back(atoms, a->get<double>("k") * kcal, a->get<double>("theta0") * pi__ / 180.0);
+      excluded_.insert(minmax(atoms[0], atoms[2]));
+    }
+  }
+  vdw_.resize(natom, {{0.0, 0.0}});
+  if (auto vdw = idata->get_child_optional("vdw"))
+    for (auto& v : *vdw)
+      vdw_[atom_index(v->get<int>("atom"))] = {{v->get<double>("epsilon") * kcal, v->get<double>("sigma") / au2angstrom__}};
+
+  cutoff_ = idata->get<double>("cutoff", 12.0) / au2angstrom__;
+
+  int nmm = 0;
+  for (auto& a : geom->atoms())
+    if (a->dummy()) ++nmm;
+  cout << "  * In-process QM/MM: " << nmm << " MM charges, " << bonds_.size() << " bonds, " << angles_.size() << " angles" << endl;
+}
+
+
+tuple<double,shared_ptr<GradFile>> QMMM_Internal::do_grad(const int natom) const {
+  Timer timer;
+  assert(current_ && current_->natom() == natom);
+  auto out = make_shared<GradFile>(natom);
+  double mmen = 0.0;
+
+  auto displ = [this](const int i, const int j) {
+    const array<double,3>& a = current_->atoms(i)->position();
+    const array<double,3>& b = current_->atoms(j)->position();
+    return array<double,3>{{a[0]-b[0], a[1]-b[1], a[2]-b[2]}};
+  };
+  auto norm = [](const array<double,3>& a) { return sqrt(a[0]*a[0] + a[1]*a[1] + a[2]*a[2]); };
+
+  for (auto& b : bonds_) {
+    const array<int,2>& atoms = get<0>(b);
+    const array<double,3> rab = displ(atoms[0], atoms[1]);
+    const double r = norm(rab);
+    const double dr = r - get<2>(b);
+    mmen += get<1>(b) * dr * dr;
+    const double fac = 2.0 * get<1>(b) * dr / r;
+    for (int l = 0; l != 3; ++l) {
+      out->element(l, atoms[0]) += fac * rab[l];
+      out->element(l, atoms[1]) -= fac * rab[l];
+    }
+  }
+
+  for (auto& a : angles_) {
+    const array<int,3>& atoms = get<0>(a);
+    const array<double,3> u = displ(atoms[0], atoms[1]);
+    const array<double,3> v = displ(atoms[2], atoms[1]);
+    const double nu = norm(u);
+    const double nv = norm(v);
+    const double cost = max(-1.0, min(1.0, (u[0]*v[0] + u[1]*v[1] + u[2]*v[2]) / (nu*nv)));
+    const double theta = acos(cost);
+    const double dtheta = theta - get<2>(a);
+    mmen += get<1>(a) * dtheta * dtheta;
+    const double sint = sqrt(1.0 - cost*cost);
+    if (sint < 1.0e-8) continue;
+    // dE/dx = 2k (theta - theta0) dtheta/dcos dcos/dx
+    const double fac = -2.0 * get<1>(a) * dtheta / sint;
+    for (int l = 0; l != 3; ++l) {
+      const double ga = fac * (v[l] / (nu*nv) - cost * u[l] / (nu*nu));
+      const double gc = fac * (u[l] / (nu*nv) - cost * v[l] / (nv*nv));
+      out->element(l, atoms[0]) += ga;
+      out->element(l, atoms[2]) += gc;
+      out->element(l, atoms[1]) -= ga + gc;
+    }
+  }
+
+  // non-bonded terms that involve at least one MM atom; QM-MM electrostatics are included in the QM Hamiltonian
+  const bool coulomb = current_->skip_self_interaction();
+  for (int i = 0; i != natom; ++i) {
+    const shared_ptr<const Atom> ai = current_->atoms(i);
+    for (int j = 0; j != i; ++j) {
+      const shared_ptr<const Atom> aj = current_->atoms(j);
+      if (!ai->dummy() && !aj->dummy()) continue;
+      if (excluded_.count({j, i})) continue;
+      const array<double,3> rij = displ(i, j);
+      const double r = norm(rij);
+      if (r > cutoff_) continue;
+
+      double dedr = 0.0;
+      const double eps = sqrt(vdw_[i][0] * vdw_[j][0]);
+      if (eps != 0.0) {
+        const double sigma = 0.5 * (vdw_[i][1] + vdw_[j][1]);
+        const double s6 = pow(sigma / r, 6);
+        mmen += 4.0 * eps * (s6*s6 - s6);
+        dedr += 4.0 * eps * (-12.0*s6*s6 + 6.0*s6) / r;
+      }
+      if (coulomb && ai->dummy() && aj->dummy()) {
+        const double qq = ai->atom_charge() * aj->atom_charge();
+        mmen += qq / r;
+        dedr -= qq / (r*r);
+      }
+      for (int l = 0; l != 3; ++l) {
+        out->element(l, i) += dedr * rij[l] / r;
+        out->element(l, j) -= dedr * rij[l] / r;
+      }
+    }
+  }
+
+  stringstream ss; ss << "MM energy = " << setw(10) << setprecision(5) << mmen;
+  timer.tick_print(ss.str());
+
+  return make_tuple(mmen, out);
+}
@@ -31,6 +31,7 @@
 #include <fstream>
 #include <string>
 #include <algorithm>
+#include <set>
 #include <src/grad/gradeval.h>
 #include <src/util/timer.h>
 #include <src/util/io/moldenout.h>
@@ -61,5 +62,31 @@ class QMMM_Tinker : public QMMM {
     std::tuple<double,std::shared_ptr<GradFile>> do_grad(const int natom) const override;
 };
 
+
+
+// MM region held in memory. The MM atoms are the point charges ("Q" atoms) in the geometry, whose field enters Hcore
+// through the nuclear attraction integrals. This class adds harmonic bonds and angles, Lennard-Jones terms and the
+// Coulomb interaction between MM charges (which the QM code skips), all read once from the "mm" input block.
+class QMMM_Internal : public QMMM {
+  protected:
+    // atoms, force constant and equilibrium value in atomic units (E = k (x - x0)^2)
+    std::vector<std::tuple<std::array<int,2>, double, double>> bonds_;
+    std::vector<std::tuple<std::array<int,3>, double, double>> angles_;
+    // epsilon and sigma for each atom (zero when not given)
+    std::vector<std::array<double,2>> vdw_;
+    // 1-2 and 1-3 pairs that have no non-bonded interaction
+    std::set<std::pair<int,int>> excluded_;
+    // non-bonded cutoff
+    double cutoff_;
+
+    mutable std::shared_ptr<const Geometry> current_;
+
+  public:
+    QMMM_Internal(std::shared_ptr<const PTree> idata, std::shared_ptr<const Geometry> geom);
+
+    void edit_input(std::shared_ptr<const Geometry> current) const override { current_ = current; }
+    std::tuple<double,std::shared_ptr<GradFile>> do_grad(const int natom) const override;
+};
+
 }
 #endif
@@ -35,7 +35,7 @@ using namespace std;
 
 static const double pisq__ = pi__ * pi__;
 
-Node::Node(const bitset<nbit__> key, const int depth, shared_ptr<const Node> parent, const double thresh)
+Node::Node(const bitset<nbit_key__> key, const int depth, shared_ptr<const Node> parent, const double thresh)
  : key_(key), depth_(depth), parent_(parent), thresh_(thresh) {
   if (depth == 0)
     key_[0] = 1;
@@ -39,7 +39,7 @@ namespace bagel {
 class Node {
   friend class Tree;
   protected:
-    std::bitset<nbit__> key_;
+    std::bitset<nbit_key__> key_;
     int depth_;
     std::shared_ptr<const Node> parent_;
     std::vector<std::weak_ptr<const Node>> children_;
@@ -90,12 +90,12 @@ class Node {
     void sort_neighbours(std::vector<std::shared_ptr<const Node>> neighbours);
 
   public:
-    Node(const std::bitset<nbit__> key = 0, const int depth = 0,
+    Node(const std::bitset<nbit_key__> key = 0, const int depth = 0,
          std::shared_ptr<const Node> parent = NULL, const double thresh = PRIM_SCREEN_THRESH);
 
     ~Node() { }
 
-    std::bitset<nbit__> key() const { return key_; }
+    std::bitset<nbit_key__> key() const { return key_; }
     int depth() const { return depth_; }
 
     std::shared_ptr<const Node> parent() const { return parent_; }
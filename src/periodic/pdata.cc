@@ -24,10 +24,62 @@
 //
 
 #include <src/periodic/pdata.h>
+#include <src/util/constants.h>
 
 using namespace std;
 using namespace bagel;
 
+namespace {
+
+// in-place mixed-radix FFT of n vectors of length len stored one after another: x_k <- sum_j exp(sign 2 pi i jk/n) x_j
+void fft(complex<double>* data, const int n, const size_t len, const int sign) {
+  if (n == 1) return;
+
+  int p = 2;
+  while (n % p != 0) ++p;
+  const int q = n / p;
+
+  vector<complex<double>> work(n * len);
+  // work(s, t) = data(s + p t), which is transformed over t for each s
+  for (int s = 0; s != p; ++s)
+    for (int t = 0; t != q; ++t)
+      copy_n(data + (s + p * t) * len, len, work.data() + (s * q + t) * len);
+  for (int s = 0; s != p; ++s)
+    fft(work.data() + s * q * len, q, len, sign);
+
+  fill_n(data, n * len, 0.0);
+  for (int k = 0; k != n; ++k) {
+    complex<double>* target = data + k * len;
+    for (int s = 0; s != p; ++s) {
+      const complex<double> w = polar(1.0, sign * 2.0 * pi__ * ((s * k) % n) / n);
+      const complex<double>* source = work.data() + (s * q + k % q) * len;
+      for (size_t l = 0; l != len; ++l)
+        target[l] += w * source[l];
+    }
+  }
+}
+
+
+// applies fft along each of ndim dimensions of an array with n points per dimension (dimension 0 runs fastest)
+void fft_nd(complex<double>* data, const int ndim, const int n, const size_t len, const int sign) {
+  const size_t total = pow(n, ndim);
+  vector<complex<double>> line(n * len);
+  size_t stride = 1;
+  for (int d = 0; d != ndim; ++d) {
+    for (size_t i = 0; i != total; ++i) {
+      if ((i / stride) % n != 0) continue;
+      for (int j = 0; j != n; ++j)
+        copy_n(data + (i + j * stride) * len, len, line.data() + j * len);
+      fft(line.data(), n, len, sign);
+      for (int j = 0; j != n; ++j)
+        copy_n(line.data() + j * len, len, data + (i + j * stride) * len);
+    }
+    stride *= n;
+  }
+}
+
+}
+
 BOOST_CLASS_EXPORT_IMPLEMENT(PData)
 
 PData::PData(const int bsize, const int nblock, const bool serial) : blocksize_(bsize), nblock_(nblock) {
@@ -153,6 +205,129 @@ void PData::print_real_part(const string tag, const int size) const {
 
 shared_ptr<const PData> PData::ft(const vector<array<double, 3>> gvector, const vector<array<double, 3>> kvector) const {
 
+  assert(gvector.size() == nblock_);
+  int ndim, ng, nk;
+  if (regular_mesh(gvector, kvector, ndim, ng, nk))
+    return ft_fft(ndim, ng, nk);
+  return ft_direct(gvector, kvector);
+}
+
+
+shared_ptr<const PData> PData::ift(const vector<array<double, 3>> gvector, const vector<array<double, 3>> kvector) const {
+
+  assert(kvector.size() == nblock_);
+  int ndim, ng, nk;
+  if (regular_mesh(gvector, kvector, ndim, ng, nk))
+    return ift_fft(ndim, ng, nk);
+  return ift_direct(gvector, kvector);
+}
+
+
+bool PData::regular_mesh(const vector<array<double, 3>>& gvector, const vector<array<double, 3>>& kvector, int& ndim, int& ng, int& nk) {
+
+  // Lattice generates g = sum_i n_i a_i with -(ng-1)/2 <= n_i <= (ng-1)/2 (first dimension fastest) and
+  // k = sum_i u_i b_i with u_i = (2r_i - nk + 1)/(2nk), r_i = 0..nk-1 (first dimension slowest), where a_i b_j = 2 pi delta_ij
+  for (ndim = 3; ndim > 0; --ndim) {
+    ng = lround(pow(gvector.size(), 1.0/ndim));
+    nk = lround(pow(kvector.size(), 1.0/ndim));
+    if (pow(ng, ndim) != gvector.size() || pow(nk, ndim) != kvector.size() || ng % 2 == 0 || nk % 2 == 0)
+      continue;
+
+    bool regular = true;
+    for (int g = 0; g != gvector.size() && regular; ++g) {
+      array<int, 3> n = {{0, 0, 0}};
+      for (int i = 0, gg = g; i != ndim; ++i, gg /= ng)
+        n[i] = gg % ng - (ng - 1) / 2;
+      for (int k = 0; k != kvector.size(); ++k) {
+        double phase = 0.0;
+        for (int i = ndim-1, kk = k; i >= 0; --i, kk /= nk)
+          phase += n[i] * (2.0 * (kk % nk) - nk + 1.0) / (2.0 * nk);
+        phase *= 2.0 * pi__;
+        const double exponent = gvector[g][0] * kvector[k][0] + gvector[g][1] * kvector[k][1] + gvector[g][2] * kvector[k][2];
+        if (fabs(exponent - phase) > 1.0e-8 * max(1.0, fabs(phase))) {
+          regular = false;
+          break;
+        }
+      }
+    }
+    if (regular) return true;
+  }
+  return false;
+}
+
+
+shared_ptr<const PData> PData::ft_fft(const int ndim, const int ng, const int nk) const {
+
+  const size_t len = blocksize_ * blocksize_;
+  const int nkvec = pow(nk, ndim);
+
+  // fold the lattice onto the k mesh (n_i -> n_i mod nk) after applying the phase from the offset of the Monkhorst-Pack grid
+  vector<complex<double>> data(nkvec * len);
+  for (int g = 0; g != nblock_; ++g) {
+    shared_ptr<const ZMatrix> gblock = pdata(g);
+    assert (gblock->get_imag_part()->rms() < 1e-10); // gblock should be real
+    double offset = 0.0;
+    int m = 0;
+    for (int i = 0, gg = g, stride = 1; i != ndim; ++i, gg /= ng, stride *= nk) {
+      const int n = gg % ng - (ng - 1) / 2;
+      offset += n;
+      m += (((n % nk) + nk) % nk) * stride;
+    }
+    const complex<double> w = polar(1.0, -pi__ * offset * (nk - 1.0) / nk);
+    blas::ax_plus_y_n(w, gblock->data(), len, data.data() + m * len);
+  }
+
+  fft_nd(data.data(), ndim, nk, len, 1);
+
+  PData out(blocksize_, nkvec);
+  for (int m = 0; m != nkvec; ++m) {
+    // kvector index runs over the first dimension slowest
+    int k = 0;
+    for (int i = 0, mm = m; i != ndim; ++i, mm /= nk)
+      k += (mm % nk) * pow(nk, ndim-1-i);
+    copy_n(data.data() + m * len, len, out[k]->data());
+  }
+
+  return make_shared<const PData>(out);
+}
+
+
+shared_ptr<const PData> PData::ift_fft(const int ndim, const int ng, const int nk) const {
+
+  const size_t len = blocksize_ * blocksize_;
+  const int nkvec = pow(nk, ndim);
+  const int ngvec = pow(ng, ndim);
+
+  vector<complex<double>> data(nkvec * len);
+  for (int m = 0; m != nkvec; ++m) {
+    int k = 0;
+    for (int i = 0, mm = m; i != ndim; ++i, mm /= nk)
+      k += (mm % nk) * pow(nk, ndim-1-i);
+    copy_n(pdata(k)->data(), len, data.data() + m * len);
+  }
+
+  fft_nd(data.data(), ndim, nk, len, -1);
+
+  // the result is periodic in n_i with period nk
+  PData out(blocksize_, ngvec);
+  for (int g = 0; g != ngvec; ++g) {
+    double offset = 0.0;
+    int m = 0;
+    for (int i = 0, gg = g, stride = 1; i != ndim; ++i, gg /= ng, stride *= nk) {
+      const int n = gg % ng - (ng - 1) / 2;
+      offset += n;
+      m += (((n % nk) + nk) % nk) * stride;
+    }
+    const complex<double> w = polar(1.0/nkvec, pi__ * offset * (nk - 1.0) / nk);
+    blas::ax_plus_y_n(w, data.data() + m * len, len, out[g]->data());
+  }
+
+  return make_shared<const PData>(out);
+}
+
+
+shared_ptr<const PData> PData::ft_direct(const vector<array<double, 3>>& gvector, const vector<array<double, 3>>& kvector) const {
+
   PData out(blocksize_, kvector.size());
 
   int k = 0;
@@ -179,7 +354,7 @@ shared_ptr<const PData> PData::ft(const vector<array<double, 3>> gvector, const
 }
 
 
-shared_ptr<const PData> PData::ift(const vector<array<double, 3>> gvector, const vector<array<double, 3>> kvector) const {
+shared_ptr<const PData> PData::ift_direct(const vector<array<double, 3>>& gvector, const vector<array<double, 3>>& kvector) const {
 
   PData out(blocksize_, gvector.size());
 
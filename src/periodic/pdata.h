@@ -39,6 +39,16 @@ class PData {
 
     std::vector<std::shared_ptr<ZMatrix>> pdata_;     // (g, i, j)
 
+    // direct sums over all pairs of lattice vectors and k vectors
+    std::shared_ptr<const PData> ft_direct(const std::vector<std::array<double, 3>>& gvector, const std::vector<std::array<double, 3>>& kvector) const;
+    std::shared_ptr<const PData> ift_direct(const std::vector<std::array<double, 3>>& gvector, const std::vector<std::array<double, 3>>& kvector) const;
+    // FFT on the lattice and Monkhorst-Pack grids generated by Lattice (ng and nk points in each of ndim dimensions)
+    std::shared_ptr<const PData> ft_fft(const int ndim, const int ng, const int nk) const;
+    std::shared_ptr<const PData> ift_fft(const int ndim, const int ng, const int nk) const;
+    // checks if the vectors are such grids; if not, ft and ift use the direct sums
+    static bool regular_mesh(const std::vector<std::array<double, 3>>& gvector, const std::vector<std::array<double, 3>>& kvector,
+                             int& ndim, int& ng, int& nk);
+
   private:
     // serialization
     friend class boost::serialization::access;
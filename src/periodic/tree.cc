@@ -47,7 +47,7 @@ Tree::Tree(shared_ptr<const Geometry> geom, const int maxht, const bool do_contr
 
 void Tree::init() {
 
-  assert(max_height_ <= (nbit__ - 1)/3);
+  assert(max_height_ <= (nbit_key__ - 1)/3);
   position_ = geom_->charge_center();
   atomgroup_.resize(geom_->natom());
   coordinates_.resize(geom_->natom());
@@ -174,16 +174,16 @@ void Tree::build_tree() {
   nodes_.resize(nnode_);
   nodes_[0] = make_shared<Node>();
 
-  bitset<nbit__>  current_key;
+  bitset<nbit_key__>  current_key;
   const int max_height = max_height_;
   for (int i = 1; i <= max_height; ++i) { /* top down */
     const int depth = i;
 
-    const unsigned int shift = nbit__ - 1 - i * 3;
+    const unsigned int shift = nbit_key__ - 1 - i * 3;
 
     int max_nbody = 0;
     for (int n = 0; n != nvertex_; ++n) {
-      const bitset<nbit__> key = (leaves_[n]->key() >> shift);
+      const bitset<nbit_key__> key = (leaves_[n]->key() >> shift);
 
       if (key != current_key) { /* insert node */
         current_key = key;
@@ -194,7 +194,7 @@ void Tree::build_tree() {
           (nodes_[nnode_])->insert_vertex(leaves_[n]);
           nodes_[0]->insert_child(nodes_[nnode_]);
         } else {
-          const bitset<nbit__> parent_key = key >> 3;
+          const bitset<nbit_key__> parent_key = key >> 3;
           bool parent_found = false;
           for (int j = 0; j != nnode_; ++j) {
             if (parent_key == nodes_[j]->key()) {
@@ -308,12 +308,12 @@ void Tree::get_particle_key() {
 
   particle_keys_.resize(nvertex_);
 
-  const unsigned int nbitx = (nbit__ - 1) / 3;
+  const unsigned int nbitx = (nbit_key__ - 1) / 3;
 
   int iat = 0;
   for (auto& pos : coordinates_) {
-    bitset<nbit__> key;
-    key[nbit__-1] = 1;
+    bitset<nbit_key__> key;
+    key[nbit_key__-1] = 1;
     bitset<nbitx> binx(pos[0]);
     bitset<nbitx> biny(pos[1]);
     bitset<nbitx> binz(pos[2]);
@@ -332,8 +332,8 @@ void Tree::keysort() {
 
   vector<int> id0(nvertex_), id1(nvertex_);
 
-  for (int i = 0; i != nbit__ - 1; ++i) { // Morton order
-    vector<bitset<nbit__>> key0(nvertex_), key1(nvertex_);
+  for (int i = 0; i != nbit_key__ - 1; ++i) { // Morton order
+    vector<bitset<nbit_key__>> key0(nvertex_), key1(nvertex_);
     int n0 = 0, n1 = 0;
     for (int n = 0; n != nvertex_; ++n) {
       if (particle_keys_[n][i] == 0) {
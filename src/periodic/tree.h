@@ -49,7 +49,7 @@ class Tree {
     std::vector<std::array<double, 3>> coordinates_;
     std::array<double, 3> position_;
 
-    std::vector<std::bitset<nbit__>> particle_keys_;
+    std::vector<std::bitset<nbit_key__>> particle_keys_;
     std::vector<std::shared_ptr<const Vertex>> leaves_;
     std::vector<int> ordering_, shell_id_;
     int nnode_, nleaf_;
@@ -66,7 +66,7 @@ class Tree {
 
     void init();
     void build_tree();
-    void get_particle_key(); // a place holder and (nbit__-1)/3 per coordinate
+    void get_particle_key(); // a place holder and (nbit_key__-1)/3 per coordinate
     void keysort();
 
     std::shared_ptr<const ZMatrix> compute_interactions(std::shared_ptr<const Matrix> density, const double schwarz_thresh = 0.0) const;
@@ -74,7 +74,7 @@ class Tree {
     std::shared_ptr<const ZMatrix> compute_JK(std::shared_ptr<const Matrix> density, const int nint) const;
 
   public:
-    Tree(std::shared_ptr<const Geometry> geom, const int max_height = (nbit__ - 1)/3, const bool do_contract = false,
+    Tree(std::shared_ptr<const Geometry> geom, const int max_height = (nbit_key__ - 1)/3, const bool do_contract = false,
          const int lmax = 10, const double thresh = PRIM_SCREEN_THRESH, const int ws = 2);
     ~Tree() { }
 
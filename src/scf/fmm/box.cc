@@ -240,8 +240,13 @@ void Box::compute_M2M(shared_ptr<const Matrix> density) {
     }
     tasks.compute();
   } else { // shift children's multipoles
+    vector<complex<double>> work(FMMTranslation::work_size(lmax_, 1));
     for (int n = 0; n != nchild_; ++n) {
       shared_ptr<const Box> c = child_[n].lock();
+      if (m2m_[n]) {
+        m2m_[n]->apply(FMMTranslation::Type::M2M, lmax_, 1, c->olm()->data(), olm_->data(), work.data());
+        continue;
+      }
       const array<double, 3> r12 = {{c->centre(0) - centre_[0], c->centre(1) - centre_[1], c->centre(2) - centre_[2]}};
       auto cmultipole = make_shared<ZMatrix>(1, nmult_);
       copy_n(c->olm()->data(), nmult_, cmultipole->data());
@@ -301,8 +306,13 @@ void Box::compute_M2M_X(shared_ptr<const Matrix> ocoeff_sj, shared_ptr<const Mat
     zgemm_("C", "N", icoeff.mdim(), interm.mdim(), nshell0_, 1.0, icoeff.data(), nshell0_, interm.data(), nshell0_, 0.0, olm_ji_->data(), icoeff.mdim());
 
   } else { // shift children's multipoles
+    vector<complex<double>> work(FMMTranslation::work_size(lmax_k_, olm_ji_->ndim()));
     for (int n = 0; n != nchild_; ++n) {
       shared_ptr<const Box> c = child_[n].lock();
+      if (m2m_[n]) {
+        m2m_[n]->apply(FMMTranslation::Type::M2M, lmax_k_, olm_ji_->ndim(), c->olm_ji()->data(), olm_ji_->data(), work.data());
+        continue;
+      }
       const array<double, 3> r12 = {{c->centre(0) - centre_[0], c->centre(1) - centre_[1], c->centre(2) - centre_[2]}};
       shared_ptr<const ZMatrix> smoment = shift_multipolesX(lmax_k_, c->olm_ji(), r12);
       blas::ax_plus_y_n(1.0, smoment->data(), olm_ji_->size(), olm_ji_->data());
@@ -315,7 +325,10 @@ void Box::compute_L2L_X() {
 
   // from parent
   shared_ptr<const Box> parent = parent_.lock();
-  if (parent) {
+  if (parent && l2l_) {
+    vector<complex<double>> work(FMMTranslation::work_size(lmax_k_, mlm_ji_->ndim()));
+    l2l_->apply(FMMTranslation::Type::L2L, lmax_k_, mlm_ji_->ndim(), parent->mlm_ji()->data(), mlm_ji_->data(), work.data());
+  } else if (parent) {
     const array<double, 3> r12 = {{centre_[0] - parent->centre(0), centre_[1] - parent->centre(1), centre_[2] - parent->centre(2)}};
     shared_ptr<const ZMatrix> slocal = shift_localLX(lmax_k_, parent->mlm_ji(), r12);
     blas::ax_plus_y_n(1.0, slocal->data(), mlm_ji_->size(), mlm_ji_->data());
@@ -327,7 +340,10 @@ void Box::compute_L2L() {
 
   // from parent
   shared_ptr<const Box> parent = parent_.lock();
-  if (parent) {
+  if (parent && l2l_) {
+    vector<complex<double>> work(FMMTranslation::work_size(lmax_, 1));
+    l2l_->apply(FMMTranslation::Type::L2L, lmax_, 1, parent->mlm()->data(), mlm_->data(), work.data());
+  } else if (parent) {
     const array<double, 3> r12 = {{centre_[0] - parent->centre(0), centre_[1] - parent->centre(1), centre_[2] - parent->centre(2)}};
     auto plocalJ = make_shared<ZMatrix>(1, nmult_);
     copy_n(parent->mlm()->data(), nmult_, plocalJ->data());
@@ -344,8 +360,13 @@ void Box::compute_M2L_X() {
   mlm_ji_ = olm_ji_->clone();
 
   // from interaction list
+  vector<complex<double>> work(FMMTranslation::work_size(lmax_k_, mlm_ji_->ndim()));
   for (int i = 0; i != ninter_; ++i) {
     shared_ptr<const Box> it = inter_[i].lock();
+    if (m2l_[i]) {
+      m2l_[i]->apply(FMMTranslation::Type::M2L, lmax_k_, mlm_ji_->ndim(), it->olm_ji()->data(), mlm_ji_->data(), work.data());
+      continue;
+    }
     const array<double, 3> r12 = {{centre_[0] - it->centre(0), centre_[1] - it->centre(1), centre_[2] - it->centre(2)}};
     shared_ptr<const ZMatrix> slocal = shift_localMX(lmax_k_, it->olm_ji(), r12);
     blas::ax_plus_y_n(1.0, slocal->data(), mlm_ji_->size(), mlm_ji_->data());
@@ -357,8 +378,13 @@ void Box::compute_M2L() {
 
   mlm_->fill(0.0);
   // from interaction list
+  vector<complex<double>> work(FMMTranslation::work_size(lmax_, 1));
   for (int i = 0; i != ninter_; ++i) {
     shared_ptr<const Box> it = inter_[i].lock();
+    if (m2l_[i]) {
+      m2l_[i]->apply(FMMTranslation::Type::M2L, lmax_, 1, it->olm()->data(), mlm_->data(), work.data());
+      continue;
+    }
     const array<double, 3> r12 = {{centre_[0] - it->centre(0), centre_[1] - it->centre(1), centre_[2] - it->centre(2)}};
     auto imultipole = make_shared<ZMatrix>(1, nmult_);
     copy_n(it->olm()->data(), nmult_, imultipole->data());
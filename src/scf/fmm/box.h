@@ -28,6 +28,7 @@
 #define __SRC_SCF_FMM_BOX_H
 
 #include <src/molecule/shellpair.h>
+#include <src/scf/fmm/translation.h>
 
 namespace bagel {
 
@@ -58,6 +59,11 @@ class Box {
     std::shared_ptr<ZMatrix> olm_ji_;
     std::shared_ptr<ZMatrix> mlm_ji_;
 
+    // cached translation operators (from children, from the interaction list, and from parent); nullptr uses shift_*X below
+    std::vector<std::shared_ptr<const FMMTranslation>> m2m_;
+    std::vector<std::shared_ptr<const FMMTranslation>> m2l_;
+    std::shared_ptr<const FMMTranslation> l2l_;
+
     void init();
     void insert_sp(const std::vector<std::shared_ptr<const ShellPair>>&);
     void insert_child(std::weak_ptr<const Box>);
@@ -43,16 +43,20 @@ FMM::FMM(std::shared_ptr<const PTree> idata, shared_ptr<const Geometry> geom, co
   if (batchsize < 0)
     xbatchsize_ = static_cast<int>(ceil(0.5*geom->nele()/mpi__->size()));
   debug_ = idata->get<bool>("debug", false);
+  adaptive_ = idata->get<bool>("adaptive", false);
+  leaf_size_ = idata->get<int>("leaf_size", 16);
+  translation_cache_ = idata->get<int>("translation_cache", 1024);
 
   if (kbuild) {
     auto newgeom = make_shared<const Geometry>(*geom, idata->get<string>("extent_exchange", "yang"));
     geomdata_ = newgeom->fmm();
-    ns_ = idata->get<int>("ns_exchange", 2);
+    ns_ = idata->get<int>("ns_exchange", adaptive_ ? 10 : 2);
     ws_ = idata->get<double>("ws_exchange", 0.0);
     do_exchange_ = true;
+    lmax_k_ = idata->get<int>("lmax_exchange", 2);
   } else {
     geomdata_ = geom->fmm();
-    ns_ = idata->get<int>("ns", 2);
+    ns_ = idata->get<int>("ns", adaptive_ ? 10 : 2);
     ws_ = idata->get<double>("ws", 0.0);
     do_exchange_ = idata->get<bool>("exchange", true);
     lmax_k_ = idata->get<int>("lmax_exchange", 2);
@@ -92,11 +96,214 @@ void FMM::init() {
   unitsize_ = boxsize_/ns2;
   coordinates_.resize(nsp_);
 
-  get_boxes();
+  if (adaptive_)
+    get_boxes_adaptive();
+  else
+    get_boxes();
+  distribute_leaves();
+  init_translation();
 
   do_ff_ = false;
-  for (int i = 0; i != nbranch_[0]; ++i)
-    if (box_[i]->ninter_ != 0) do_ff_ = true;
+  for (auto& b : box_)
+    if (b->ninter_ != 0) do_ff_ = true;
+}
+
+
+void FMM::get_boxes_adaptive() {
+
+  Timer fmminit;
+
+  // cubes are split into octants while they hold more than leaf_size_ shell pairs, up to ns_ levels,
+  // unless the octants would be smaller than the shell pairs in them
+  struct Node {
+    array<double, 3> centre;
+    double size;
+    int depth;
+    array<int, 3> tvec;
+    vector<int> sp;
+    vector<int> child;
+  };
+  vector<Node> nodes(1);
+  nodes[0].centre = centre_;
+  nodes[0].size = boxsize_;
+  nodes[0].depth = 0;
+  nodes[0].tvec = {{0, 0, 0}};
+  nodes[0].sp.resize(nsp_);
+  iota(nodes[0].sp.begin(), nodes[0].sp.end(), 0);
+
+  for (size_t n = 0; n != nodes.size(); ++n) {
+    const Node node = nodes[n];
+    if (static_cast<int>(node.sp.size()) <= leaf_size_ || node.depth >= ns_) continue;
+    double extent = 0.0;
+    for (auto& i : node.sp)
+      extent += geomdata_->shellpair(isp_[i])->extent();
+    if (0.5*node.size < extent/node.sp.size()) continue;
+
+    array<vector<int>, 8> octant;
+    for (auto& i : node.sp) {
+      int o = 0;
+      for (int k = 0; k != 3; ++k)
+        if (coordinates_[i][k] >= node.centre[k]) o |= (1 << k);
+      octant[o].push_back(i);
+    }
+    for (int o = 0; o != 8; ++o) {
+      if (octant[o].empty()) continue;
+      Node c;
+      for (int k = 0; k != 3; ++k) {
+        c.centre[k] = node.centre[k] + ((o >> k & 1) ? 0.25 : -0.25) * node.size;
+        c.tvec[k] = 2*node.tvec[k] + (o >> k & 1);
+      }
+      c.size = 0.5*node.size;
+      c.depth = node.depth + 1;
+      c.sp = move(octant[o]);
+      nodes[n].child.push_back(nodes.size());
+      nodes.push_back(c);
+    }
+  }
+
+  // leaves first, then the other boxes from the bottom of the tree (children always come before their parent)
+  int depth = 0;
+  for (auto& n : nodes)
+    depth = max(depth, n.depth);
+  auto rank = [&](const Node& n) { return n.child.empty() ? 0 : depth - n.depth; };
+  vector<int> order(nodes.size());
+  iota(order.begin(), order.end(), 0);
+  stable_sort(order.begin(), order.end(), [&](const int a, const int b) { return rank(nodes[a]) < rank(nodes[b]); });
+
+  vector<int> position(nodes.size());
+  nbranch_.assign(depth+1, 0);
+  box_.clear();
+  for (auto& i : order) {
+    const Node& n = nodes[i];
+    vector<shared_ptr<const ShellPair>> sp;
+    for (auto& j : n.sp)
+      sp.push_back(geomdata_->shellpair(isp_[j]));
+    position[i] = box_.size();
+    box_.push_back(make_shared<Box>(rank(n), n.size, n.centre, box_.size(), n.tvec, lmax_, lmax_k_, sp, thresh_));
+    ++nbranch_[rank(n)];
+  }
+  for (size_t i = 0; i != nodes.size(); ++i)
+    for (auto& c : nodes[i].child) {
+      box_[position[i]]->insert_child(box_[position[c]]);
+      box_[position[c]]->insert_parent(box_[position[i]]);
+    }
+  nbox_ = box_.size();
+  nleaf_ = nbranch_[0];
+
+  for (auto& b : box_) {
+    b->init();
+    b->sort_sp();
+  }
+
+  // dual tree traversal: well-separated pairs go to the interaction lists, the rest are opened until both are leaves
+  for (auto& b : box_) {
+    b->neigh_.clear();
+    b->inter_.clear();
+  }
+  auto separated = [&](shared_ptr<const Box> a, shared_ptr<const Box> b) {
+    double rr = 0.0;
+    for (int i = 0; i != 3; ++i) rr += pow(a->centre(i) - b->centre(i), 2);
+    return sqrt(rr) > (1.0+ws_)*(a->extent() + b->extent());
+  };
+  function<void(const int, const int)> dual = [&](const int a, const int b) {
+    shared_ptr<Box> ba = box_[a];
+    shared_ptr<Box> bb = box_[b];
+    const vector<int>& ca = nodes[order[a]].child;
+    const vector<int>& cb = nodes[order[b]].child;
+    if (a == b) {
+      if (ca.empty()) {
+        ba->neigh_.push_back(ba);
+      } else {
+        for (auto i = ca.begin(); i != ca.end(); ++i)
+          for (auto j = i; j != ca.end(); ++j)
+            dual(position[*i], position[*j]);
+      }
+    } else if (separated(ba, bb)) {
+      ba->inter_.push_back(bb);
+      bb->inter_.push_back(ba);
+    } else if (ca.empty() && cb.empty()) {
+      ba->neigh_.push_back(bb);
+      bb->neigh_.push_back(ba);
+    } else if (cb.empty() || (!ca.empty() && ba->extent() >= bb->extent())) {
+      for (auto& i : ca)
+        dual(position[i], b);
+    } else {
+      for (auto& i : cb)
+        dual(a, position[i]);
+    }
+  };
+  dual(nbox_-1, nbox_-1);
+  for (auto& b : box_) {
+    b->nneigh_ = b->neigh_.size();
+    b->ninter_ = b->inter_.size();
+  }
+
+  size_t nnear = 0, nfar = 0;
+  for (auto& b : box_) {
+    nnear += b->nneigh_;
+    nfar += b->ninter_;
+  }
+  cout << "    * Adaptive FMM tree: " << nbox_ << " boxes, " << nleaf_ << " leaves, " << depth << " levels, "
+       << nnear << " near-field and " << nfar << " far-field box pairs" << endl;
+  fmminit.tick_print("FMM initialisation");
+}
+
+
+void FMM::distribute_leaves() {
+  // leaves are assigned to processes by the estimated cost of their near-field work (largest first, to the least loaded process)
+  vector<pair<double, int>> cost;
+  for (int i = 0; i != nbranch_[0]; ++i) {
+    double nneigh = 0.0;
+    for (auto& n : box_[i]->neigh_)
+      nneigh += n.lock()->nsp_;
+    cost.emplace_back(box_[i]->nsp_ * (nneigh + 1.0), i);
+  }
+  stable_sort(cost.begin(), cost.end(), [](const pair<double, int>& a, const pair<double, int>& b) { return a.first > b.first; });
+
+  owner_.resize(nbranch_[0]);
+  vector<double> load(mpi__->size(), 0.0);
+  for (auto& i : cost) {
+    const int r = min_element(load.begin(), load.end()) - load.begin();
+    owner_[i.second] = r;
+    load[r] += i.first;
+  }
+}
+
+
+void FMM::init_translation() {
+
+  Timer transtime;
+
+  // operators are computed up to the larger of the two expansion orders and shared by the box pairs with the same offset
+  const int lmax = do_exchange_ ? max(lmax_, lmax_k_) : lmax_;
+  FMMTranslationCache cache(lmax, static_cast<size_t>(translation_cache_) << 20);
+
+  auto offset = [](shared_ptr<const Box> a, shared_ptr<const Box> b) {
+    return array<double, 3>{{a->centre(0) - b->centre(0), a->centre(1) - b->centre(1), a->centre(2) - b->centre(2)}};
+  };
+
+  // M2M and L2L first as they are used by every box; M2L operators beyond the memory limit are computed on the fly
+  for (auto& b : box_) {
+    b->m2m_.clear();
+    for (auto& c : b->child_)
+      b->m2m_.push_back(cache.get(offset(c.lock(), b)));
+    shared_ptr<const Box> parent = b->parent();
+    b->l2l_ = parent ? cache.get(offset(b, parent)) : nullptr;
+  }
+  int nfallback = 0;
+  for (auto& b : box_) {
+    b->m2l_.clear();
+    for (auto& i : b->inter_) {
+      b->m2l_.push_back(cache.get(offset(b, i.lock())));
+      if (!b->m2l_.back()) ++nfallback;
+    }
+  }
+
+  cout << "    * " << cache.size() << " translation operators cached (" << setprecision(1) << fixed << cache.memory()/1.0e6 << " MB)";
+  if (nfallback)
+    cout << ", " << nfallback << " M2L pairs beyond the limit";
+  cout << endl;
+  transtime.tick_print("FMM translation operators");
 }
 
 
@@ -273,16 +480,16 @@ void FMM::M2M(shared_ptr<const Matrix> density, const bool dox) const {
 
   Timer m2mtime;
   for (int i = 0; i != nbranch_[0]; ++i)
-    if (i % mpi__->size() == mpi__->rank())
+    if (owner_[i] == mpi__->rank())
       box_[i]->compute_M2M(density);
 
   for (int i = 0; i != nbranch_[0]; ++i)
-    mpi__->broadcast(box_[i]->olm()->data(), box_[i]->olm()->size(), i % mpi__->size());
+    mpi__->broadcast(box_[i]->olm()->data(), box_[i]->olm()->size(), owner_[i]);
 
   m2mtime.tick_print("Compute multipoles");
 
   int icnt = nbranch_[0];
-  for (int i = 1; i != ns_+1; ++i) {
+  for (int i = 1; i != nbranch_.size(); ++i) {
     for (int j = 0; j != nbranch_[i]; ++j, ++icnt)
       box_[icnt]->compute_M2M(density);
   }
@@ -296,7 +503,7 @@ void FMM::M2M_X(shared_ptr<const Matrix> ocoeff_sj, shared_ptr<const Matrix> oco
   Timer m2mtime;
 
   int icnt = 0;
-  for (int i = 0; i != ns_+1; ++i) {
+  for (int i = 0; i != nbranch_.size(); ++i) {
     for (int j = 0; j != nbranch_[i]; ++j, ++icnt) {
       box_[icnt]->compute_M2M_X(ocoeff_sj, ocoeff_ui);
       if (icnt >= nbox_) throw logic_error("Trying to access beyond nbox in M2M_X");
@@ -336,7 +543,7 @@ void FMM::L2L(const bool dox) const {
 
   int icnt = 0;
   if (!dox) {
-    for (int ir = ns_; ir > -1; --ir) {
+    for (int ir = nbranch_.size()-1; ir > -1; --ir) {
       for (int ib = 0; ib != nbranch_[ir]; ++ib)
         box_[nbox_-icnt-nbranch_[ir]+ib]->compute_L2L();
 
@@ -345,7 +552,7 @@ void FMM::L2L(const bool dox) const {
 
     l2ltime.tick_print("L2L pass");
   } else {
-    for (int ir = ns_; ir > -1; --ir) {
+    for (int ir = nbranch_.size()-1; ir > -1; --ir) {
       for (int ib = 0; ib != nbranch_[ir]; ++ib) {
         const int ibox = nbox_-icnt-nbranch_[ir]+ib;
         box_[ibox]->compute_L2L_X();
@@ -395,7 +602,7 @@ shared_ptr<const Matrix> FMM::compute_Fock_FMM(shared_ptr<const Matrix> density)
 
     auto ff = make_shared<Matrix>(nbasis_, nbasis_);
     for (int i = 0; i != nbranch_[0]; ++i)
-      if (i % mpi__->size() == mpi__->rank()) {
+      if (owner_[i] == mpi__->rank()) {
         auto ei = box_[i]->compute_Fock_nf(density, maxden);
         blas::ax_plus_y_n(1.0, ei->data(), nbasis_*nbasis_, out->data());
         auto ffi = box_[i]->compute_Fock_ff(density);
@@ -520,7 +727,7 @@ shared_ptr<const Matrix> FMM::compute_Fock_FMM_K(shared_ptr<const Matrix> densit
     }
 
     for (int i = 0; i != nbranch_[0]; ++i)
-      if (i % mpi__->size() == mpi__->rank()) {
+      if (owner_[i] == mpi__->rank()) {
         auto ei = box_[i]->compute_Fock_nf_K(density, maxden);
         blas::ax_plus_y_n(1.0, ei->data(), nbasis_*nbasis_, out->data());
       }
@@ -572,7 +779,7 @@ shared_ptr<const Matrix> FMM::compute_Fock_FMM_J(shared_ptr<const Matrix> densit
 
     auto ff = make_shared<Matrix>(nbasis_, nbasis_);
     for (int i = 0; i != nbranch_[0]; ++i)
-      if (i % mpi__->size() == mpi__->rank()) {
+      if (owner_[i] == mpi__->rank()) {
         auto ffi = box_[i]->compute_Fock_ff(density);
         blas::ax_plus_y_n(1.0, ffi->data(), nbasis_*nbasis_, ff->data());
       }
@@ -580,7 +787,7 @@ shared_ptr<const Matrix> FMM::compute_Fock_FMM_J(shared_ptr<const Matrix> densit
     fmmtime.tick_print("FMM-J");
 
     for (int i = 0; i != nbranch_[0]; ++i)
-      if (i % mpi__->size() == mpi__->rank()) {
+      if (owner_[i] == mpi__->rank()) {
         auto ei = box_[i]->compute_Fock_nf_J(density, maxden);
         blas::ax_plus_y_n(1.0, ei->data(), nbasis_*nbasis_, out->data());
       }
@@ -53,9 +53,19 @@ class FMM {
     bool debug_;
     int xbatchsize_;
     double thresh_;
+    // memory (in MB) for the cached translation operators
+    int translation_cache_;
+    // adaptive octree (up to ns_ levels) with at most leaf_size_ shell pairs per leaf
+    bool adaptive_;
+    int leaf_size_;
+    // process that computes each leaf
+    std::vector<int> owner_;
 
     void init();
     void get_boxes();
+    void get_boxes_adaptive();
+    void distribute_leaves();
+    void init_translation();
     void M2M(std::shared_ptr<const Matrix> mat, const bool do_exchange = false) const;
     void M2M_X(std::shared_ptr<const Matrix> ocoeff_sj, std::shared_ptr<const Matrix> ocoeff_ui) const;
     void M2L(const bool do_exchange = false) const;
@@ -66,13 +76,13 @@ class FMM {
     template<class Archive>
     void save(Archive& ar, const unsigned int) const {
       ar << ns_ << lmax_ << ws_ << do_exchange_ << lmax_k_ << debug_ << xbatchsize_ << geomdata_
-         << centre_ << nbasis_ << thresh_;
+         << centre_ << nbasis_ << thresh_ << translation_cache_ << adaptive_ << leaf_size_;
     }
 
     template<class Archive>
     void load(Archive& ar, const unsigned int) {
       ar >> ns_ >> lmax_ >> ws_ >> do_exchange_ >> lmax_k_ >> debug_ >> xbatchsize_ >> geomdata_
-         >> centre_ >> nbasis_ >> thresh_;
+         >> centre_ >> nbasis_ >> thresh_ >> translation_cache_ >> adaptive_ >> leaf_size_;
       init();
     }
 
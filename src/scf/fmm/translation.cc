@@ -0,0 +1,195 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: translation.cc
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <src/scf/fmm/translation.h>
+#include <src/util/f77.h>
+
+using namespace std;
+using namespace bagel;
+
+namespace {
+
+// d^l(beta) = exp(-i beta J_y) by scaling and squaring; rows are m', columns m (both from -l to l)
+vector<double> wigner_d(const int l, const double beta) {
+  const int n = 2*l+1;
+  vector<double> a(n*n, 0.0);
+  for (int m = -l; m < l; ++m) {
+    // -i J_y = -(J+ - J-)/2
+    const double jp = sqrt(static_cast<double>((l-m)*(l+m+1)));
+    a[(m+1+l) + n*(m+l)] = -0.5 * jp * beta;
+    a[(m+l) + n*(m+1+l)] =  0.5 * jp * beta;
+  }
+  int nsquare = 0;
+  const double norm = fabs(beta) * (l+1);
+  if (norm > 0.25)
+    nsquare = static_cast<int>(ceil(log2(norm/0.25)));
+  const double scale = pow(0.5, nsquare);
+  for (auto& i : a) i *= scale;
+
+  // Taylor series in Horner form: 1 + A(1 + A/2(1 + A/3(...)))
+  vector<double> out(n*n, 0.0), tmp(n*n);
+  for (int i = 0; i != n; ++i) out[i*(n+1)] = 1.0;
+  for (int k = 18; k >= 1; --k) {
+    dgemm_("N", "N", n, n, n, 1.0/k, a.data(), n, out.data(), n, 0.0, tmp.data(), n);
+    for (int i = 0; i != n; ++i) tmp[i*(n+1)] += 1.0;
+    swap(out, tmp);
+  }
+  for (int s = 0; s != nsquare; ++s) {
+    dgemm_("N", "N", n, n, n, 1.0, out.data(), n, out.data(), n, 0.0, tmp.data(), n);
+    swap(out, tmp);
+  }
+  return out;
+}
+
+}
+
+
+FMMTranslation::FMMTranslation(const int lmax, const array<double,3>& r) : lmax_(lmax) {
+  r_ = sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2]);
+  theta_ = r_ > 0.0 ? acos(max(-1.0, min(1.0, r[2]/r_))) : 0.0;
+  phi_ = atan2(r[1], r[0]);
+
+  size_t size = 0;
+  for (int l = 0; l <= lmax_; ++l) {
+    offset_.push_back(size);
+    size += (2*l+1)*(2*l+1);
+  }
+  wigner_.reserve(size);
+  for (int l = 0; l <= lmax_; ++l) {
+    const vector<double> d = wigner_d(l, theta_);
+    wigner_.insert(wigner_.end(), d.begin(), d.end());
+  }
+
+  nu_.resize((lmax_+1)*(lmax_+1));
+  for (int l = 0; l <= lmax_; ++l)
+    for (int m = -l; m <= l; ++m)
+      nu_[l*l+m+l] = exp(-0.5 * (lgamma(l+m+1.0) + lgamma(l-m+1.0)));
+
+  phase_.resize(2*lmax_+1);
+  for (int m = -lmax_; m <= lmax_; ++m)
+    phase_[m+lmax_] = polar(1.0, m*phi_);
+
+  rpow_.resize(lmax_+1);
+  rpow_[0] = 1.0;
+  for (int k = 1; k <= lmax_; ++k)
+    rpow_[k] = rpow_[k-1] * r_ / k;
+
+  rinv_.resize(2*lmax_+1);
+  rinv_[0] = 1.0 / r_;
+  for (int k = 1; k <= 2*lmax_; ++k)
+    rinv_[k] = rinv_[k-1] * k / r_;
+}
+
+
+// The expansions are in terms of O_lm = (-1)^m nu_lm r^l C_l,-m (multipoles) and I_lm = C_lm / (nu_lm r^(l+1)) (local),
+// where C_lm are the Racah-normalized spherical harmonics and nu_lm = 1/sqrt((l+m)!(l-m)!). Rotations about the y axis are therefore
+// N d^l N^-1 for multipoles and N^-1 d^l N for local expansions, with N = diag(nu).
+void FMMTranslation::apply(const Type type, const int lmax, const size_t n, const complex<double>* in, complex<double>* out, complex<double>* work) const {
+  assert(lmax <= lmax_);
+  const int nmult = (lmax+1)*(lmax+1);
+  complex<double>* const work1 = work;
+  complex<double>* const work2 = work + n*nmult;
+
+  const bool in_local  = type == Type::L2L;
+  const bool out_local = type != Type::M2M;
+
+  // rotation by R_y(-theta) R_z(-phi)
+  for (int l = 0; l <= lmax; ++l) {
+    for (int m = -l; m <= l; ++m) {
+      const int lm = l*l+m+l;
+      const complex<double> fac = in_local ? nu_[lm] * conj(phase_[m+lmax_]) : phase_[m+lmax_] / nu_[lm];
+      const complex<double>* source = in + n*lm;
+      complex<double>* target = work1 + n*lm;
+      for (size_t i = 0; i != n; ++i)
+        target[i] = fac * source[i];
+    }
+    // complex data times a real matrix
+    dgemm_("N", "N", 2*n, 2*l+1, 2*l+1, 1.0, reinterpret_cast<double*>(work1 + n*l*l), 2*n, wigner_.data()+offset_[l], 2*l+1,
+                                        0.0, reinterpret_cast<double*>(work2 + n*l*l), 2*n);
+  }
+
+  // translation along z, including the normalization of the rotations
+  fill_n(work1, n*nmult, 0.0);
+  for (int l = 0; l <= lmax; ++l) {
+    for (int m = -l; m <= l; ++m) {
+      const int lm = l*l+m+l;
+      complex<double>* target = work1 + n*lm;
+      int jstart, jfence;
+      if (type == Type::M2M) {
+        jstart = abs(m); jfence = l+1;
+      } else if (type == Type::M2L) {
+        jstart = abs(m); jfence = lmax+1;
+      } else {
+        jstart = l; jfence = lmax+1;
+      }
+      for (int j = jstart; j < jfence; ++j) {
+        const int jm = type == Type::M2L ? j*j-m+j : j*j+m+j;
+        double coeff;
+        if (type == Type::M2M)
+          coeff = rpow_[l-j] * nu_[jm] / nu_[lm];
+        else if (type == Type::M2L)
+          coeff = (l & 1 ? -1.0 : 1.0) * rinv_[l+j] * nu_[jm] * nu_[lm];
+        else
+          coeff = rpow_[j-l] * nu_[lm] / nu_[jm];
+        const complex<double>* source = work2 + n*jm;
+        for (size_t i = 0; i != n; ++i)
+          target[i] += coeff * source[i];
+      }
+    }
+  }
+
+  // rotation back by R_z(phi) R_y(theta)
+  for (int l = 0; l <= lmax; ++l) {
+    dgemm_("N", "T", 2*n, 2*l+1, 2*l+1, 1.0, reinterpret_cast<double*>(work1 + n*l*l), 2*n, wigner_.data()+offset_[l], 2*l+1,
+                                        0.0, reinterpret_cast<double*>(work2 + n*l*l), 2*n);
+    for (int m = -l; m <= l; ++m) {
+      const int lm = l*l+m+l;
+      const complex<double> fac = out_local ? phase_[m+lmax_] / nu_[lm] : nu_[lm] * conj(phase_[m+lmax_]);
+      const complex<double>* source = work2 + n*lm;
+      complex<double>* target = out + n*lm;
+      for (size_t i = 0; i != n; ++i)
+        target[i] += fac * source[i];
+    }
+  }
+}
+
+
+shared_ptr<const FMMTranslation> FMMTranslationCache::get(const array<double,3>& r) {
+  // offsets are identified on a 1.0e-8 bohr grid
+  const array<long long,3> key{{llround(r[0]*1.0e8), llround(r[1]*1.0e8), llround(r[2]*1.0e8)}};
+  auto iter = map_.find(key);
+  if (iter != map_.end())
+    return iter->second;
+
+  if (memory_ + FMMTranslation::memory_size(lmax_) > max_memory_)
+    return nullptr;
+  auto out = make_shared<const FMMTranslation>(lmax_, r);
+  memory_ += out->memory_size();
+  map_.emplace(key, out);
+  return out;
+}
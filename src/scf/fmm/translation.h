@@ -0,0 +1,99 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: translation.h
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __SRC_SCF_FMM_TRANSLATION_H
+#define __SRC_SCF_FMM_TRANSLATION_H
+
+#include <map>
+#include <array>
+#include <tuple>
+#include <memory>
+#include <vector>
+#include <complex>
+
+namespace bagel {
+
+// Translation of multipole (M2M, M2L) and local (L2L) expansions along a vector r.
+// The translation is factorized as a rotation that brings r onto the z axis, a translation along z, and the inverse rotation,
+// each of which costs O(lmax^3) per row of the expansions (instead of O(lmax^4) for the explicit operator).
+// The Wigner d matrices of the polar angle are stored together with the azimuthal phases, the normalization factors and the powers of r,
+// so that apply performs no transcendental function calls and no allocation.
+class FMMTranslation {
+  public:
+    enum class Type { M2M, M2L, L2L };
+
+  protected:
+    const int lmax_;
+    double r_, theta_, phi_;
+    // d^l(theta) for l = 0..lmax, each (2l+1) x (2l+1), stored one after another
+    std::vector<double> wigner_;
+    std::vector<size_t> offset_;
+    // nu_lm = 1/sqrt((l+m)!(l-m)!) at lm = l*l+m+l
+    std::vector<double> nu_;
+    // exp(i m phi) for m = -lmax..lmax
+    std::vector<std::complex<double>> phase_;
+    // r^k/k! for k = 0..lmax (M2M and L2L) and k!/r^(k+1) for k = 0..2*lmax (M2L)
+    std::vector<double> rpow_;
+    std::vector<double> rinv_;
+
+  public:
+    FMMTranslation(const int lmax, const std::array<double,3>& r);
+
+    int lmax() const { return lmax_; }
+    size_t memory_size() const { return (wigner_.size() + nu_.size() + rpow_.size() + rinv_.size()) * sizeof(double) + phase_.size() * sizeof(std::complex<double>); }
+    static size_t memory_size(const int lmax) {
+      return ((lmax+1)*(2*lmax+1)*(2*lmax+3)/3 + (lmax+1)*(lmax+1) + 3*lmax+2) * sizeof(double) + (2*lmax+1) * sizeof(std::complex<double>);
+    }
+
+    // workspace (in complex numbers) needed by apply for n rows
+    static size_t work_size(const int lmax, const size_t n) { return 2 * n * (lmax+1) * (lmax+1); }
+
+    // out(n, lm) += sum_jk T(lm, jk) in(n, jk), where T is the translation operator of the given type up to lmax <= lmax().
+    // Both are column-major with n rows; work should have at least work_size(lmax, n) elements.
+    void apply(const Type type, const int lmax, const size_t n, const std::complex<double>* in, std::complex<double>* out, std::complex<double>* work) const;
+};
+
+
+// The operators for the box pairs with the same relative position are shared
+class FMMTranslationCache {
+  protected:
+    const int lmax_;
+    const size_t max_memory_;
+    size_t memory_;
+    std::map<std::array<long long,3>, std::shared_ptr<const FMMTranslation>> map_;
+
+  public:
+    FMMTranslationCache(const int lmax, const size_t max_memory) : lmax_(lmax), max_memory_(max_memory), memory_(0) { }
+
+    // returns nullptr when the memory limit is reached (the caller should fall back to the explicit operators)
+    std::shared_ptr<const FMMTranslation> get(const std::array<double,3>& r);
+
+    size_t size() const { return map_.size(); }
+    size_t memory() const { return memory_; }
+};
+
+}
+
+#endif
@@ -123,7 +123,11 @@ void RHF_London::compute() {
 #endif
     if (!dodf_) {
       shared_ptr<ZMatrix> prev = previous_fock->copy();
-      previous_fock = make_shared<Fock_London<0>>(geom_, previous_fock, densitychange, schwarz_);
+      // periodically rebuild from the full density to remove accumulated errors
+      if (iter % fock_reset_ == 0)
+        previous_fock = make_shared<Fock_London<0>>(geom_, hcore_, aodensity_, schwarz_);
+      else
+        previous_fock = make_shared<Fock_London<0>>(geom_, previous_fock, densitychange, schwarz_);
       mpi__->broadcast(const_pointer_cast<ZMatrix>(previous_fock)->data(), previous_fock->size(), 0);
     } else {
       previous_fock = make_shared<Fock_London<1>>(geom_, hcore_, nullptr, coeff_->slice(0, nocc_), do_grad_, true/*rhf*/);
@@ -23,14 +23,89 @@
 //
 
 #include <src/scf/hf/fock.h>
+#include <src/util/taskqueue.h>
 
 using namespace std;
 using namespace bagel;
 
 
+namespace bagel {
+// Pool of Fock matrices that accumulate the two-electron contributions. Each buffer is owned by one thread at a time,
+// so that the tasks do not have to lock when they scatter integrals into the Fock matrix. The number of buffers
+// equals the number of threads, since the number of concurrent tasks cannot exceed it (see Resources::get()).
+class FockBufferPool {
+  protected:
+    std::vector<std::shared_ptr<Matrix>> buffer_;
+    std::unique_ptr<std::atomic_flag[]> flag_;
+
+  public:
+    FockBufferPool(const int ndim, const int nthread) : flag_(new std::atomic_flag[nthread]) {
+      for (int i = 0; i != nthread; ++i) {
+        buffer_.push_back(std::make_shared<Matrix>(ndim, ndim));
+        flag_[i].clear();
+      }
+    }
+
+    int get() {
+      for (int i = 0; i != buffer_.size(); ++i)
+        if (!flag_[i].test_and_set())
+          return i;
+      throw std::runtime_error("Fock buffers exhausted");
+      return -1;
+    }
+    void release(const int i) { flag_[i].clear(); }
+
+    Matrix& buffer(const int i) { return *buffer_[i]; }
+
+    // sums up the buffers in a fixed order
+    std::shared_ptr<Matrix> reduce() const {
+      std::shared_ptr<Matrix> out = buffer_.front();
+      for (auto i = buffer_.begin()+1; i != buffer_.end(); ++i)
+        *out += **i;
+      return out;
+    }
+};
+
+// Occupied orbitals that span the same density C C^T obtained by the pivoted Cholesky decomposition.
+// They are localized, which makes the (D|ir) integrals sparse.
+static shared_ptr<Matrix> cholesky_orbitals(const MatView ocoeff) {
+  const int nbasis = ocoeff.extent(0);
+  const int nocc = ocoeff.extent(1);
+  Matrix ct(nocc, nbasis);
+  for (int i = 0; i != nocc; ++i)
+    for (int j = 0; j != nbasis; ++j)
+      ct(i, j) = ocoeff(j, i);
+
+  vector<double> diag(nbasis);
+  for (int j = 0; j != nbasis; ++j)
+    diag[j] = blas::dot_product(ct.element_ptr(0, j), nocc, ct.element_ptr(0, j));
+  const double tol = 1.0e-12 * max(1.0, *max_element(diag.begin(), diag.end()));
+
+  auto out = make_shared<Matrix>(nbasis, nocc);
+  int rank = 0;
+  for ( ; rank != nocc; ++rank) {
+    const int p = max_element(diag.begin(), diag.end()) - diag.begin();
+    if (diag[p] < tol)
+      break;
+    // column p of C C^T minus the previous vectors
+    double* const l = out->element_ptr(0, rank);
+    dgemv_("T", nocc, nbasis, 1.0, ct.data(), nocc, ct.element_ptr(0, p), 1, 0.0, l, 1);
+    for (int k = 0; k != rank; ++k)
+      blas::ax_plus_y_n(-out->element(p, k), out->element_ptr(0, k), nbasis, l);
+    blas::scale_n(1.0/sqrt(diag[p]), l, nbasis);
+    for (int j = 0; j != nbasis; ++j)
+      diag[j] -= l[j]*l[j];
+    diag[p] = 0.0;
+  }
+  return rank == nocc ? out : out->slice_copy(0, rank);
+}
+}
+
+
 // Non-DF Fock matrix, standard basis
 template <>
 void Fock<0>::fock_two_electron_part(shared_ptr<const Matrix> den) {
+  Profile prof("Fock build");
   const vector<shared_ptr<const Atom>> atoms = geom_->atoms();
   vector<shared_ptr<const Shell>> basis;
   vector<int> offset;
@@ -42,10 +117,10 @@ void Fock<0>::fock_two_electron_part(shared_ptr<const Matrix> den) {
     offset.insert(offset.end(), tmpoff.begin(), tmpoff.end());
   }
 
-  const int shift = sizeof(int) * 4;
   const int size = basis.size();
 
   // first make max_density_change vector for each batch pair.
+  // In incremental builds density_ is the density change, so that the screening tightens as the SCF converges.
   const double* density_data = density_->data();
 
   vector<double> max_density_change(size * size);
@@ -70,61 +145,91 @@ void Fock<0>::fock_two_electron_part(shared_ptr<const Matrix> den) {
     }
   }
 
+  // returns the density-weighted integral bound for a shell quartet (negative if the quartet is screened out)
+  auto quartet_bound = [&](const int i0, const int i1, const int i2, const int i3) {
+    const double density_01 = max_density_change[i0 * size + i1] * 4.0;
+    const double density_23 = max_density_change[i2 * size + i3] * 4.0;
+    const double density_02 = max_density_change[i0 * size + i2];
+    const double density_03 = max_density_change[i0 * size + i3];
+    const double density_12 = max_density_change[i1 * size + i2];
+    const double density_13 = max_density_change[i1 * size + i3];
+    const double mulfactor = max(max(max(density_01, density_02),
+                                     max(density_03, density_12)),
+                                     max(density_13, density_23));
+    const double integral_bound = mulfactor * schwarz_[i0 * size + i1] * schwarz_[i2 * size + i3];
+    return integral_bound < schwarz_thresh_ ? -1.0 : mulfactor;
+  };
+
   ////////////////////////////////////////////
   // starting 2-e Fock matrix evaluation!
   ////////////////////////////////////////////
-  //////////////// ONLY FOR REFERENCES. //////////////////
 
+  // one task per bra shell pair (i0 <= i1), which loops over the ket pairs. Costs are estimated
+  // by the number of integrals in the surviving quartets and used to balance the work among processes
+  vector<tuple<size_t, int, int>> bra;
   for (int i0 = 0; i0 != size; ++i0) {
-    const shared_ptr<const Shell>  b0 = basis[i0];
-    const int b0offset = offset[i0];
-    const int b0size = b0->nbasis();
     for (int i1 = i0; i1 != size; ++i1) {
-      const unsigned int i01 = i0 *size + i1;
-
-      const shared_ptr<const Shell>  b1 = basis[i1];
-      const int b1offset = offset[i1];
-      const int b1size = b1->nbasis();
-
-      const double density_change_01 = max_density_change[i01] * 4.0;
-
+      const unsigned int i01 = i0 * size + i1;
+      const size_t size01 = basis[i0]->nbasis() * basis[i1]->nbasis();
+      size_t cost = 0;
       for (int i2 = i0; i2 != size; ++i2) {
-        const shared_ptr<const Shell>  b2 = basis[i2];
-        const int b2offset = offset[i2];
-        const int b2size = b2->nbasis();
-
-        const double density_change_02 = max_density_change[i0 * size + i2];
-        const double density_change_12 = max_density_change[i1 * size + i2];
-
         for (int i3 = i2; i3 != size; ++i3) {
           const unsigned int i23 = i2 * size + i3;
           if (i23 < i01) continue;
+          if (quartet_bound(i0, i1, i2, i3) < 0.0) {
+            ++nskipped_;
+            continue;
+          }
+          ++ncomputed_;
+          cost += size01 * basis[i2]->nbasis() * basis[i3]->nbasis();
+        }
+      }
+      if (cost > 0)
+        bra.emplace_back(cost, i0, i1);
+    }
+  }
+  // the most expensive tasks first, which are assigned to the least loaded process
+  stable_sort(bra.begin(), bra.end(), [](const tuple<size_t, int, int>& a, const tuple<size_t, int, int>& b) { return get<0>(a) > get<0>(b); });
+
+  vector<size_t> load(mpi__->size());
+  vector<tuple<size_t, int, int>> mybra;
+  for (auto& i : bra) {
+    const int rank = min_element(load.begin(), load.end()) - load.begin();
+    load[rank] += get<0>(i);
+    if (rank == mpi__->rank())
+      mybra.push_back(i);
+  }
 
-          const double density_change_23 = max_density_change[i2 * size + i3] * 4.0;
-          const double density_change_03 = max_density_change[i0 * size + i2];
-          const double density_change_13 = max_density_change[i0 * size + i2];
-
+  FockBufferPool buffers(ndim(), resources__->max_num_threads());
+
+  TaskQueue<function<void(void)>> tasks(mybra.size());
+  for (auto& task : mybra) {
+    const int i0 = get<1>(task);
+    const int i1 = get<2>(task);
+    tasks.emplace_back(
+      [this, i0, i1, size, &basis, &offset, &quartet_bound, &buffers, density_data]() {
+        const int shift = sizeof(int) * 4;
+        const unsigned int i01 = i0 * size + i1;
+
+        const shared_ptr<const Shell>  b0 = basis[i0];
+        const int b0offset = offset[i0];
+        const int b0size = b0->nbasis();
+        const shared_ptr<const Shell>  b1 = basis[i1];
+        const int b1offset = offset[i1];
+        const int b1size = b1->nbasis();
+
+        const int ibuf = buffers.get();
+        Matrix& out = buffers.buffer(ibuf);
+
+        // adds the contribution of the quartet (i3, i2, i1, i0)
+        auto digest = [&](const double* eridata, const int i2, const int i3) {
+          const unsigned int i23 = i2 * size + i3;
           const bool eqli01i23 = (i01 == i23);
-
-          const shared_ptr<const Shell>  b3 = basis[i3];
+          const int b2offset = offset[i2];
+          const int b2size = basis[i2]->nbasis();
           const int b3offset = offset[i3];
-          const int b3size = b3->nbasis();
+          const int b3size = basis[i3]->nbasis();
 
-          const double mulfactor = max(max(max(density_change_01, density_change_02),
-                                           max(density_change_12, density_change_23)),
-                                           max(density_change_03, density_change_13));
-          const double integral_bound = mulfactor * schwarz_[i01] * schwarz_[i23];
-          const bool skip_schwarz = integral_bound < schwarz_thresh_;
-          if (skip_schwarz) continue;
-
-          array<shared_ptr<const Shell>,4> input = {{b3, b2, b1, b0}};
-#ifdef LIBINT_INTERFACE
-          Libint eribatch(input);
-#else
-          ERIBatch eribatch(input, mulfactor);
-#endif
-          eribatch.compute();
-          const double* eridata = eribatch.data();
           for (int j0 = b0offset; j0 != b0offset + b0size; ++j0) {
             const int j0n = j0 * ndim();
 
@@ -161,21 +266,80 @@ void Fock<0>::fock_two_electron_part(shared_ptr<const Matrix> den) {
                   double intval = *eridata * scal01 * (j2 == j3 ? 0.5 : 1.0) * (nj01 == nj23 ? 0.25 : 0.5); // 1/2 in the Hamiltonian absorbed here
                   const double intval4 = 4.0 * intval;
 
-                  element(j1, j0) += density_data[j2n + j3] * intval4;
-                  element(j3, j2) += density_data[j0n + j1] * intval4;
-                  element(j3, j0) -= density_data[j1n + j2] * intval;
-                  element(maxj1j2, minj1j2) -= density_data[j0n + j3] * intval;
-                  element(maxj0j2, minj0j2) -= density_data[j1n + j3] * intval;
-                  element(maxj1j3, minj1j3) -= density_data[j0n + j2] * intval;
+                  out.element(j1, j0) += density_data[j2n + j3] * intval4;
+                  out.element(j3, j2) += density_data[j0n + j1] * intval4;
+                  out.element(j3, j0) -= density_data[j1n + j2] * intval;
+                  out.element(maxj1j2, minj1j2) -= density_data[j0n + j3] * intval;
+                  out.element(maxj0j2, minj0j2) -= density_data[j1n + j3] * intval;
+                  out.element(maxj1j3, minj1j3) -= density_data[j0n + j2] * intval;
                 }
               }
             }
           }
+        };
 
+#ifdef LIBINT_INTERFACE
+        for (int i2 = i0; i2 != size; ++i2) {
+          for (int i3 = i2; i3 != size; ++i3) {
+            const unsigned int i23 = i2 * size + i3;
+            if (i23 < i01 || quartet_bound(i0, i1, i2, i3) < 0.0) continue;
+
+            array<shared_ptr<const Shell>,4> input = {{basis[i3], basis[i2], b1, b0}};
+            Libint eribatch(input);
+            eribatch.compute();
+            digest(eribatch.data(), i2, i3);
+          }
+        }
+#else
+        // surviving ket pairs are grouped by class, and each group is evaluated by ERIClassBatch
+        struct KetGroup {
+          array<shared_ptr<const Shell>,4> first;
+          vector<pair<int,int>> ket;
+          vector<double> mulfactor;
+        };
+        vector<KetGroup> groups;
+        for (int i2 = i0; i2 != size; ++i2) {
+          for (int i3 = i2; i3 != size; ++i3) {
+            const unsigned int i23 = i2 * size + i3;
+            if (i23 < i01) continue;
+
+            const double mulfactor = quartet_bound(i0, i1, i2, i3);
+            if (mulfactor < 0.0) continue;
+
+            array<shared_ptr<const Shell>,4> input = {{basis[i3], basis[i2], b1, b0}};
+            auto iter = find_if(groups.begin(), groups.end(), [&input](const KetGroup& g) { return ERIClassBatch::same_class(g.first, input); });
+            if (iter == groups.end())
+              iter = groups.insert(groups.end(), KetGroup{input, {}, {}});
+            iter->ket.emplace_back(i2, i3);
+            iter->mulfactor.push_back(mulfactor);
+          }
         }
+
+        // the number of quartets evaluated together is capped so that the buffers stay small
+        const int maxbatch = ERIClassBatch::max_nbatch();
+        for (auto& g : groups) {
+          for (int start = 0; start < g.ket.size(); start += maxbatch) {
+            const int n = min(maxbatch, static_cast<int>(g.ket.size()) - start);
+            vector<array<shared_ptr<const Shell>,4>> input;
+            for (int k = start; k != start + n; ++k)
+              input.push_back({{basis[g.ket[k].second], basis[g.ket[k].first], b1, b0}});
+            ERIClassBatch eribatch(input, vector<double>(g.mulfactor.begin()+start, g.mulfactor.begin()+start+n));
+            eribatch.compute();
+            for (int k = 0; k != n; ++k)
+              digest(eribatch.data(k), g.ket[start+k].first, g.ket[start+k].second);
+          }
+        }
+#endif
+        buffers.release(ibuf);
       }
-    }
+    );
   }
+  tasks.compute();
+
+  shared_ptr<Matrix> fock2e = buffers.reduce();
+  fock2e->allreduce();
+  *this += *fock2e;
+
   for (int i = 0; i != ndim(); ++i) element(i, i) *= 2.0;
   fill_upper();
 }
@@ -183,6 +347,7 @@ void Fock<0>::fock_two_electron_part(shared_ptr<const Matrix> den) {
 
 template<int DF>
 void Fock<DF>::fock_two_electron_part(shared_ptr<const Matrix> den_ex) {
+  Profile prof("Fock build");
   static_assert(DF == 1, "Wrong Fock matrix implementation is being compiled.");
 #ifndef NDEBUG
   cout << "    .. warning .. use a new Fock builder if possible (coeff_ required)" << endl;
@@ -227,14 +392,43 @@ void Fock<DF>::fock_two_electron_part(shared_ptr<const Matrix> den_ex) {
 
 
 template<int DF>
-void Fock<DF>::fock_two_electron_part_with_coeff(const MatView ocoeff, const bool rhf, const double scale_exchange, const double scale_coulomb) {
+void Fock<DF>::fock_two_electron_part_with_coeff(const MatView ocoeff, const bool rhf, const double scale_exchange, const double scale_coulomb,
+                                                  const double exch_thresh) {
+  Profile prof("Fock build");
   if (DF == 0) throw logic_error("Fock<DF>::fock_two_electron_part_with_coeff() is only for DF cases");
 
   Timer pdebug(3);
 
   shared_ptr<const DFDist> df = geom_->df();
 
-  if (scale_exchange != 0.0) {
+  if (scale_exchange != 0.0 && exch_thresh > 0.0 && !store_half_) {
+    // exchange with localized occupied orbitals, in which negligible blocks of (D|ir) are skipped
+    shared_ptr<const Matrix> lcoeff = cholesky_orbitals(ocoeff);
+    vector<int> bounds(1, 0);
+    for (auto& a : geom_->atoms())
+      if (a->nbasis())
+        bounds.push_back(bounds.back() + a->nbasis());
+
+    shared_ptr<DFHalfDist> halfbj = df->compute_half_transform_screened(*lcoeff, bounds, exch_thresh);
+    pdebug.tick_print("First index transform");
+
+    shared_ptr<DFHalfDist> half = halfbj->apply_J();
+    pdebug.tick_print("Metric multiply");
+
+    *this += *half->form_2index_screened(bounds, exch_thresh, -1.0*scale_exchange);
+    pdebug.tick_print("Exchange build");
+
+    // Coulomb from the full density; the screened half-transformed integrals are only accurate enough for exchange
+    if (rhf) {
+      Matrix oc(ocoeff);
+      *this += *df->compute_Jop(make_shared<const Matrix>((oc ^ oc) * (2.0*scale_coulomb)));
+    } else {
+      shared_ptr<Matrix> jop = df->compute_Jop(density_);
+      if (scale_coulomb != 1.0)
+        jop->scale(scale_coulomb);
+      *this += *jop;
+    }
+  } else if (scale_exchange != 0.0) {
     shared_ptr<DFHalfDist> halfbj = df->compute_half_transform(ocoeff);
     pdebug.tick_print("First index transform");
 
@@ -29,6 +29,7 @@
 #include <src/df/df.h>
 #include <src/integral/libint/libint.h>
 #include <src/integral/rys/eribatch.h>
+#include <src/integral/rys/ericlassbatch.h>
 #include <src/scf/hf/fock_base.h>
 
 namespace bagel {
@@ -37,12 +38,17 @@ template<int DF>
 class Fock : public Fock_base {
   protected:
     void fock_two_electron_part(std::shared_ptr<const Matrix> den = nullptr);
-    void fock_two_electron_part_with_coeff(const MatView coeff, const bool rhf, const double scale_ex, const double scale_coulomb);
+    // when exch_thresh is positive, exchange is computed with localized orbitals and screening (unless store_half_ is set)
+    void fock_two_electron_part_with_coeff(const MatView coeff, const bool rhf, const double scale_ex, const double scale_coulomb, const double exch_thresh);
 
     // when DF gradients are requested
     bool store_half_;
     std::shared_ptr<DFHalfDist> half_;
 
+    // screening statistics of non-DF Fock builds (unique shell quartets)
+    size_t ncomputed_ = 0;
+    size_t nskipped_ = 0;
+
   private:
     // serialization
     friend class boost::serialization::access;
@@ -56,16 +62,18 @@ class Fock : public Fock_base {
     // Fock operator for DF cases
     template<int DF1 = DF, class = typename std::enable_if<DF1==1>::type>
     Fock(std::shared_ptr<const Geometry> a, std::shared_ptr<const Matrix> prev, std::shared_ptr<const Matrix> den,
-         const MatView ocoeff, const bool store = false, const bool rhf = false, const double scale_ex = 1.0, const double scale_coulomb = 1.0)
+         const MatView ocoeff, const bool store = false, const bool rhf = false, const double scale_ex = 1.0, const double scale_coulomb = 1.0,
+         const double exch_thresh = 0.0)
      : Fock_base(a,prev,den), store_half_(store) {
-      fock_two_electron_part_with_coeff(ocoeff, rhf, scale_ex, scale_coulomb);
+      fock_two_electron_part_with_coeff(ocoeff, rhf, scale_ex, scale_coulomb, exch_thresh);
       fock_one_electron_part();
     }
     // the same as above.
     template<typename T, class = typename std::enable_if<btas::is_boxtensor<T>::value>::type>
     Fock(std::shared_ptr<const Geometry> a, std::shared_ptr<const Matrix> prev, std::shared_ptr<const Matrix> den,
-         std::shared_ptr<T> ocoeff, const bool store = false, const bool rhf = false, const double scale_ex = 1.0, const double scale_coulomb = 1.0)
-     : Fock(a,prev,den,*ocoeff,store,rhf,scale_ex,scale_coulomb) {
+         std::shared_ptr<T> ocoeff, const bool store = false, const bool rhf = false, const double scale_ex = 1.0, const double scale_coulomb = 1.0,
+         const double exch_thresh = 0.0)
+     : Fock(a,prev,den,*ocoeff,store,rhf,scale_ex,scale_coulomb,exch_thresh) {
     }
 
     // Fock operator
@@ -83,6 +91,9 @@ class Fock : public Fock_base {
     }
 
     std::shared_ptr<DFHalfDist> half() const { return half_; }
+
+    size_t ncomputed() const { return ncomputed_; }
+    size_t nskipped() const { return nskipped_; }
 };
 
 // specialized for non-DF cases
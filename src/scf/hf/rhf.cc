@@ -35,6 +35,15 @@ using namespace std;
 
 BOOST_CLASS_EXPORT_IMPLEMENT(RHF)
 
+// two-electron part of the closed-shell energy, 0.5 tr[D (J - K/2)] with D = 2 C C^T
+static double two_electron_energy(shared_ptr<const DFDist> df, const MatView ocoeff) {
+  shared_ptr<const DFHalfDist> half = df->compute_half_transform(ocoeff)->apply_J();
+  const Matrix oc(ocoeff);
+  Matrix g = *half->form_2index(half, -1.0);
+  g += *df->compute_Jop(half, make_shared<const Matrix>(*oc.transpose()*2.0), true);
+  return (oc % g * oc).trace();
+}
+
 RHF::RHF(const shared_ptr<const PTree> idata, const shared_ptr<const Geometry> geom, const shared_ptr<const Reference> re)
  : SCF_base(idata, geom, re, !idata->get<bool>("df",true)), dodf_(idata->get<bool>("df",true)), restarted_(false) {
 
@@ -47,6 +56,9 @@ RHF::RHF(const shared_ptr<const PTree> idata, const shared_ptr<const Geometry> g
     cout << "  level shift : " << setprecision(3) << lshift_ << endl << endl;
     levelshift_ = make_shared<ShiftVirtual<DistMatrix>>(nocc_, lshift_);
   }
+
+  // recomputes the DF integrals in double precision once at convergence
+  check_single_ = idata->get<bool>("check_single", false);
 }
 
 
@@ -90,7 +102,7 @@ void RHF::compute() {
           aodensity_ = coeff_->form_density_rhf(nocc_);
           focka = make_shared<const Fock<0>>(geom_, hcore_, aodensity_, schwarz_);
         } else {
-          focka = make_shared<const Fock<1>>(geom_, hcore_, nullptr, coeff_->slice(0, nocc_), do_grad_, true/*rhf*/);
+          focka = make_shared<const Fock<1>>(geom_, hcore_, nullptr, coeff_->slice(0, nocc_), do_grad_, true/*rhf*/, 1.0, 1.0, thresh_exchange_);
         }
       } else {
         aodensity_ = coeff_->form_density_rhf(nocc_);
@@ -122,6 +134,8 @@ void RHF::compute() {
 
   for (int iter = 0; iter != max_iter_; ++iter) {
     Timer pdebug(1);
+    // numbers of shell quartets computed and skipped in direct SCF
+    pair<size_t, size_t> nquartet;
 
 #ifndef DISABLE_SERIALIZATION
     if (restart_) {
@@ -133,10 +147,14 @@ void RHF::compute() {
 
     if (!dofmm_) {
       if (!dodf_) {
-        previous_fock = make_shared<Fock<0>>(geom_, previous_fock, densitychange, schwarz_);
-        mpi__->broadcast(const_pointer_cast<Matrix>(previous_fock)->data(), previous_fock->size(), 0);
+        // periodically rebuild from the full density to remove accumulated errors
+        const bool reset = iter % fock_reset_ == 0;
+        auto fock0 = reset ? make_shared<Fock<0>>(geom_, hcore_, aodensity_, schwarz_)
+                           : make_shared<Fock<0>>(geom_, previous_fock, densitychange, schwarz_);
+        nquartet = make_pair(fock0->ncomputed(), fock0->nskipped());
+        previous_fock = fock0;
       } else {
-        previous_fock = make_shared<Fock<1>>(geom_, hcore_, nullptr, coeff_->slice(0, nocc_), do_grad_, true/*rhf*/);
+        previous_fock = make_shared<Fock<1>>(geom_, hcore_, nullptr, coeff_->slice(0, nocc_), do_grad_, true/*rhf*/, 1.0, 1.0, thresh_exchange_);
       }
     } else {
       previous_fock = compute_Fock_FMM(aodensity_, make_shared<const Matrix>(coeff_->slice(0, nocc_)));
@@ -152,11 +170,21 @@ void RHF::compute() {
 
     cout << indent << setw(5) << iter << setw(20) << fixed << setprecision(8) << energy_ << "   "
                                       << setw(17) << error << setw(15) << setprecision(2) << scftime.tick() << endl;
+    if (!dodf_ && !dofmm_)
+      cout << indent << "        shell quartets computed: " << setw(12) << nquartet.first << "   skipped: " << setw(12) << nquartet.second << endl;
 
     if (error < thresh_scf_) {
       cout << indent << endl << indent << "  * SCF iteration converged." << endl << endl;
       if (do_grad_) half_ = dynamic_pointer_cast<const Fock<1>>(previous_fock)->half();
 
+      // validation of the single-precision integrals: the energy at the converged density is evaluated with both sets of integrals
+      if (check_single_ && dodf_ && !dofmm_ && geom_->df()->single()) {
+        const MatView ocoeff = coeff_->slice(0, nocc_);
+        const double esingle = two_electron_energy(geom_->df(), ocoeff);
+        const double edouble = two_electron_energy(geom_->form_df_double(), ocoeff);
+        cout << indent << "  * Single-precision DF integrals: energy error " << scientific << setprecision(2) << esingle - edouble << fixed << endl << endl;
+      }
+
       break;
     } else if (iter == max_iter_-1) {
       cout << indent << endl << indent << "  * Max iteration reached in SCF." << endl << endl;
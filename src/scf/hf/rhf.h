@@ -40,6 +40,9 @@ class RHF : public SCF_base {
     bool dodf_;
     bool restarted_;
 
+    // if true, the energy with single-precision DF integrals is compared with the double-precision one after convergence
+    bool check_single_;
+
     std::shared_ptr<DIIS<DistMatrix>> diis_;
     std::shared_ptr<const Matrix> compute_Fock_FMM(std::shared_ptr<const Matrix> density, std::shared_ptr<const Matrix> coeff = nullptr);
 
@@ -50,13 +53,13 @@ class RHF : public SCF_base {
     template<class Archive>
     void save(Archive& ar, const unsigned int) const {
       ar << boost::serialization::base_object<SCF_base>(*this);
-      ar << lshift_ << dodf_ << diis_;
+      ar << lshift_ << dodf_ << check_single_ << diis_;
     }
 
     template<class Archive>
     void load(Archive& ar, const unsigned int) {
       ar >> boost::serialization::base_object<SCF_base>(*this);
-      ar >> lshift_ >> dodf_ >> diis_;
+      ar >> lshift_ >> dodf_ >> check_single_ >> diis_;
       if (lshift_ != 0.0)
         levelshift_ = std::make_shared<ShiftVirtual<DistMatrix>>(nocc_, lshift_);
       restarted_ = true;
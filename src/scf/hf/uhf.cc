@@ -46,8 +46,8 @@ void UHF::initial_guess() {
     coeffB_ = make_shared<const Coeff>(*coeff_);
   } else {
     tie(aodensity_, aodensityA_, aodensityB_) = form_density_uhf();
-    auto fockA = make_shared<const Fock<1>>(geom_, hcore_, aodensity_, coeff_->slice(0, nocc_));
-    auto fockB = make_shared<const Fock<1>>(geom_, hcore_, aodensity_, coeffB_->slice(0, noccB_));
+    auto fockA = make_shared<const Fock<1>>(geom_, hcore_, aodensity_, coeff_->slice(0, nocc_), false, false, 1.0, 1.0, thresh_exchange_);
+    auto fockB = make_shared<const Fock<1>>(geom_, hcore_, aodensity_, coeffB_->slice(0, noccB_), false, false, 1.0, 1.0, thresh_exchange_);
     Matrix intermediateA = *tildex_ % *fockA * *tildex_;
     Matrix intermediateB = *tildex_ % *fockB * *tildex_;
     intermediateA.diagonalize(eig());
@@ -76,8 +76,8 @@ void UHF::compute() {
   Timer scftime;
   for (int iter = 0; iter != max_iter_; ++iter) {
 
-    shared_ptr<const Matrix> fockA = make_shared<const Fock<1>>(geom_, hcore_, aodensity_, coeff_->slice(0, nocc_));
-    shared_ptr<const Matrix> fockB = make_shared<const Fock<1>>(geom_, hcore_, aodensity_, coeffB_->slice(0, noccB_));
+    shared_ptr<const Matrix> fockA = make_shared<const Fock<1>>(geom_, hcore_, aodensity_, coeff_->slice(0, nocc_), false, false, 1.0, 1.0, thresh_exchange_);
+    shared_ptr<const Matrix> fockB = make_shared<const Fock<1>>(geom_, hcore_, aodensity_, coeffB_->slice(0, noccB_), false, false, 1.0, 1.0, thresh_exchange_);
 
     energy_ = 0.25*((*hcore_+*fockA) * *aodensityA_ + (*hcore_+*fockB) * *aodensityB_).trace() + geom_->nuclear_repulsion();
 
@@ -23,6 +23,7 @@
 //
 
 #include <numeric>
+#include <mutex>
 #include <src/scf/ks/dftgrid.h>
 #include <src/scf/ks/lebedevlist.h>
 #include <src/scf/ks/xcfunc.h>
@@ -36,30 +37,33 @@ using namespace bagel;
 const static LebedevList lebedev;
 
 
-vector<shared_ptr<const Matrix>> DFTGrid_base::compute_rho_sigma(shared_ptr<const XCFunc> func, shared_ptr<const Matrix> mat,
+vector<shared_ptr<const Matrix>> DFTGrid_base::compute_rho_sigma(shared_ptr<const XCFunc> func, const GridBatch& batch, shared_ptr<const Matrix> mat,
                                                          unique_ptr<double[]>& rho, unique_ptr<double[]>& sigma,
                                                          unique_ptr<double[]>& rhox, unique_ptr<double[]>& rhoy, unique_ptr<double[]>& rhoz) const {
   vector<shared_ptr<const Matrix>> out;
-  auto orb = make_shared<Matrix>(*mat % *grid_->basis());
+  // coefficients of the basis functions that are significant in this batch
+  shared_ptr<const Matrix> cmat = batch.gather(*mat);
+  auto orb = make_shared<Matrix>(*cmat % *batch.basis());
+  const size_t offset = batch.offset();
   if (func->lda()) {
-    assert(orb->mdim() == grid_->size());
+    assert(orb->mdim() == batch.size());
     for (size_t i = 0; i != orb->mdim(); ++i) {
-      rho[i] = 2*ddot_(orb->ndim(), orb->element_ptr(0, i), 1, orb->element_ptr(0, i), 1);
+      rho[offset+i] = 2*ddot_(orb->ndim(), orb->element_ptr(0, i), 1, orb->element_ptr(0, i), 1);
     }
     out = vector<shared_ptr<const Matrix>>{orb};
   } else {
-    auto orbx = make_shared<Matrix>(*mat % *grid_->gradx());
-    auto orby = make_shared<Matrix>(*mat % *grid_->grady());
-    auto orbz = make_shared<Matrix>(*mat % *grid_->gradz());
+    auto orbx = make_shared<Matrix>(*cmat % *batch.gradx());
+    auto orby = make_shared<Matrix>(*cmat % *batch.grady());
+    auto orbz = make_shared<Matrix>(*cmat % *batch.gradz());
     for (size_t i = 0; i != orb->mdim(); ++i) {
-      rho[i] = 2*ddot_(orb->ndim(), orb->element_ptr(0, i), 1, orb->element_ptr(0, i), 1);
+      rho[offset+i] = 2*ddot_(orb->ndim(), orb->element_ptr(0, i), 1, orb->element_ptr(0, i), 1);
       const double sigx = 2*ddot_(orb->ndim(), orb->element_ptr(0, i), 1, orbx->element_ptr(0, i), 1);
       const double sigy = 2*ddot_(orb->ndim(), orb->element_ptr(0, i), 1, orby->element_ptr(0, i), 1);
       const double sigz = 2*ddot_(orb->ndim(), orb->element_ptr(0, i), 1, orbz->element_ptr(0, i), 1);
-      sigma[i] = 4*(sigx*sigx + sigy*sigy + sigz*sigz);
-      rhox[i] = 2*sigx;
-      rhoy[i] = 2*sigy;
-      rhoz[i] = 2*sigz;
+      sigma[offset+i] = 4*(sigx*sigx + sigy*sigy + sigz*sigz);
+      rhox[offset+i] = 2*sigx;
+      rhoy[offset+i] = 2*sigy;
+      rhoz[offset+i] = 2*sigz;
     }
     out = vector<shared_ptr<const Matrix>>{orb, orbx, orby, orbz};
   }
@@ -67,101 +71,142 @@ vector<shared_ptr<const Matrix>> DFTGrid_base::compute_rho_sigma(shared_ptr<cons
 }
 
 
+void DFTGrid_base::compute_tau_lapl(const GridBatch& batch, shared_ptr<const Matrix> mat, const vector<shared_ptr<const Matrix>>& orb,
+                                    shared_ptr<const Matrix> blapl, unique_ptr<double[]>& tau, unique_ptr<double[]>& lapl) const {
+  assert(orb.size() == 4);
+  const size_t offset = batch.offset();
+  // tau = sum_i |nabla phi_i|^2 for doubly occupied orbitals (libxc convention)
+  for (size_t i = 0; i != batch.size(); ++i)
+    tau[offset+i] = ddot_(orb[1]->ndim(), orb[1]->element_ptr(0, i), 1, orb[1]->element_ptr(0, i), 1)
+                  + ddot_(orb[2]->ndim(), orb[2]->element_ptr(0, i), 1, orb[2]->element_ptr(0, i), 1)
+                  + ddot_(orb[3]->ndim(), orb[3]->element_ptr(0, i), 1, orb[3]->element_ptr(0, i), 1);
+
+  // nabla^2 rho = 4 sum_i (phi_i nabla^2 phi_i + |nabla phi_i|^2)
+  if (blapl) {
+    const Matrix orbl = *batch.gather(*mat) % *blapl;
+    for (size_t i = 0; i != batch.size(); ++i)
+      lapl[offset+i] = 4*(ddot_(orbl.ndim(), orb[0]->element_ptr(0, i), 1, orbl.element_ptr(0, i), 1) + tau[offset+i]);
+  } else {
+    fill_n(lapl.get()+offset, batch.size(), 0.0);
+  }
+}
+
+
 namespace bagel {
-class ExcVxcTask {
+class GridBatchFuncTask {
   protected:
-    const size_t size;
-    const double* rho;
-    const double* sigma;
-    double* exc;
-    double* vxc;
-    double* vxc2;
-    shared_ptr<const XCFunc> func;
+    function<void(const GridBatch&)> func_;
+    shared_ptr<const GridBatch> batch_;
   public:
-    ExcVxcTask(const size_t n, const double* r, const double* s, double* e, double* v, double* v2, shared_ptr<const XCFunc> f)
-     : size(n), rho(r), sigma(s), exc(e), vxc(v), vxc2(v2), func(f) { }
-    void compute() {
-      func->compute_exc_vxc(size, rho, sigma, exc, vxc, vxc2);
-    }
-};
-class VxcTask {
-  protected:
-    const size_t size;
-    const double* rho;
-    const double* sigma;
-    double* vxc;
-    double* vxc2;
-    shared_ptr<const XCFunc> func;
-  public:
-    VxcTask(const size_t n, const double* r, const double* s, double* v, double* v2, shared_ptr<const XCFunc> f)
-     : size(n), rho(r), sigma(s), vxc(v), vxc2(v2), func(f) { }
-    void compute() {
-      func->compute_vxc(size, rho, sigma, vxc, vxc2);
-    }
+    GridBatchFuncTask(function<void(const GridBatch&)> f, shared_ptr<const GridBatch> b) : func_(f), batch_(b) { }
+    void compute() { func_(*batch_); }
+    double cost() const { return static_cast<double>(batch_->nbasis())*batch_->size(); }
 };
 }
 
 
+void DFTGrid_base::for_each_batch(function<void(const GridBatch&)> f) const {
+  TaskQueue<GridBatchFuncTask> tasks(grid_->batches().size());
+  for (auto& i : grid_->batches())
+    tasks.emplace_back(f, i);
+  tasks.compute();
+}
+
+
 tuple<shared_ptr<const Matrix>,double> DFTGrid_base::compute_xc(shared_ptr<const XCFunc> func, shared_ptr<const Matrix> mat) const {
   Timer time;
 
+  // only the points in the batches of this process are set
   unique_ptr<double[]> rho(new double[grid_->size()]);
-  unique_ptr<double[]> sigma, rhox, rhoy, rhoz;
+  unique_ptr<double[]> sigma, rhox, rhoy, rhoz, tau, lapl;
   if (!func->lda()) {
     sigma = unique_ptr<double[]>(new double[grid_->size()]);
     rhox  = unique_ptr<double[]>(new double[grid_->size()]);
     rhoy  = unique_ptr<double[]>(new double[grid_->size()]);
     rhoz  = unique_ptr<double[]>(new double[grid_->size()]);
   }
-
-  compute_rho_sigma(func, mat, rho, sigma, rhox, rhoy, rhoz);
-
-  time.tick_print("rho, sigma");
-
-  unique_ptr<double[]> exc(new double[grid_->size()]);
-  unique_ptr<double[]> vxc(new double[grid_->size()*(func->lda()?1:2)]);
-
-  StaticDist dist(grid_->size(), min(resources__->max_num_threads()*100, grid_->size()));
-  vector<pair<size_t, size_t>> table = dist.atable();
-
-  TaskQueue<ExcVxcTask> tasks(table.size());
-  for (auto& i : table) {
-    const size_t n = i.first;
-    tasks.emplace_back(i.second, rho.get()+n, (!func->lda() ? sigma.get()+n : nullptr),
-                               exc.get()+n, vxc.get()+n, (!func->lda() ? vxc.get()+n+grid_->size() : nullptr), func);
+  if (func->mgga()) {
+    tau   = unique_ptr<double[]>(new double[grid_->size()]);
+    lapl  = unique_ptr<double[]>(new double[grid_->size()]);
   }
-  tasks.compute();
-  time.tick_print("exc+vxc");
+  // vrho, vsigma, vlapl, vtau
+  const int nv = func->lda() ? 1 : (func->mgga() ? 4 : 2);
+  unique_ptr<double[]> exc(new double[grid_->size()]);
+  unique_ptr<double[]> vxc(new double[grid_->size()*nv]);
+  double* const vsigma = nv > 1 ? vxc.get()+grid_->size() : nullptr;
+  double* const vlapl  = nv > 2 ? vxc.get()+grid_->size()*2 : nullptr;
+  double* const vtau   = nv > 2 ? vxc.get()+grid_->size()*3 : nullptr;
 
   auto out = make_shared<Matrix>(geom_->nbasis(), geom_->nbasis());
   double en = 0.0;
 
-  auto scal = make_shared<Matrix>(geom_->nbasis(), grid_->size());
-  if (func->lda()) {
-    for (size_t i = 0; i != scal->mdim(); ++i) {
-      daxpy_(scal->ndim(), vxc[i]*grid_->weight(i), grid_->basis()->element_ptr(0, i), 1, scal->element_ptr(0, i), 1);
-      en += exc[i] * rho[i] * grid_->weight(i);
+  mutex outmutex;
+  for_each_batch([&](const GridBatch& batch) {
+    vector<shared_ptr<const Matrix>> orb = compute_rho_sigma(func, batch, mat, rho, sigma, rhox, rhoy, rhoz);
+
+    const size_t n = batch.offset();
+    shared_ptr<const Matrix> blapl;
+    if (func->mgga()) {
+      if (func->need_laplacian())
+        blapl = grid_->compute_laplacian(batch);
+      compute_tau_lapl(batch, mat, orb, blapl, tau, lapl);
+      func->compute_exc_vxc(batch.size(), rho.get()+n, sigma.get()+n, lapl.get()+n, tau.get()+n,
+                            exc.get()+n, vxc.get()+n, vsigma+n, vlapl+n, vtau+n);
+    } else {
+      func->compute_exc_vxc(batch.size(), rho.get()+n, (!func->lda() ? sigma.get()+n : nullptr),
+                            exc.get()+n, vxc.get()+n, (!func->lda() ? vsigma+n : nullptr));
     }
-  } else {
-    for (size_t i = 0; i != scal->mdim(); ++i) {
-      daxpy_(scal->ndim(), vxc[i]*grid_->weight(i), grid_->basis()->element_ptr(0, i), 1, scal->element_ptr(0, i), 1);
-      daxpy_(scal->ndim(), 4*vxc[i+grid_->size()]*grid_->weight(i)*rhox[i], grid_->gradx()->element_ptr(0, i), 1, scal->element_ptr(0, i), 1);
-      daxpy_(scal->ndim(), 4*vxc[i+grid_->size()]*grid_->weight(i)*rhoy[i], grid_->grady()->element_ptr(0, i), 1, scal->element_ptr(0, i), 1);
-      daxpy_(scal->ndim(), 4*vxc[i+grid_->size()]*grid_->weight(i)*rhoz[i], grid_->gradz()->element_ptr(0, i), 1, scal->element_ptr(0, i), 1);
-      en += exc[i] * rho[i] * grid_->weight(i);
+
+    double ebatch = 0.0;
+    auto scal = make_shared<Matrix>(batch.nbasis(), batch.size());
+    for (size_t j = 0; j != batch.size(); ++j) {
+      const size_t i = n + j;
+      daxpy_(scal->ndim(), vxc[i]*grid_->weight(i), batch.basis()->element_ptr(0, j), 1, scal->element_ptr(0, j), 1);
+      if (!func->lda()) {
+        daxpy_(scal->ndim(), 4*vsigma[i]*grid_->weight(i)*rhox[i], batch.gradx()->element_ptr(0, j), 1, scal->element_ptr(0, j), 1);
+        daxpy_(scal->ndim(), 4*vsigma[i]*grid_->weight(i)*rhoy[i], batch.grady()->element_ptr(0, j), 1, scal->element_ptr(0, j), 1);
+        daxpy_(scal->ndim(), 4*vsigma[i]*grid_->weight(i)*rhoz[i], batch.gradz()->element_ptr(0, j), 1, scal->element_ptr(0, j), 1);
+      }
+      if (blapl)
+        daxpy_(scal->ndim(), 2*vlapl[i]*grid_->weight(i), blapl->element_ptr(0, j), 1, scal->element_ptr(0, j), 1);
+      ebatch += exc[i] * rho[i] * grid_->weight(i);
     }
-  }
-  *out += *scal ^ *grid_->basis();
+    Matrix contracted = *scal ^ *batch.basis();
+
+    // meta-GGA: d tau/dP = 1/2 nabla phi_mu . nabla phi_nu, and d lapl/dP contains 2 nabla phi_mu . nabla phi_nu
+    if (func->mgga()) {
+      for (auto& g : {batch.gradx(), batch.grady(), batch.gradz()}) {
+        auto sg = g->copy();
+        for (size_t j = 0; j != batch.size(); ++j) {
+          const size_t i = n + j;
+          dscal_(sg->ndim(), (0.5*vtau[i] + (blapl ? 2*vlapl[i] : 0.0))*grid_->weight(i), sg->element_ptr(0, j), 1);
+        }
+        contracted += *sg ^ *g;
+      }
+    }
+
+    lock_guard<mutex> lock(outmutex);
+    batch.scatter_add(contracted, *out);
+    en += ebatch;
+  });
+  time.tick_print("xc integration");
+
+  // sum over the batches of all the processes
+  out->allreduce();
+  mpi__->allreduce(&en, 1);
   out->symmetrize();
 
-  time.tick_print("contraction");
+  time.tick_print("xc allreduce");
   return make_tuple(out, en);
 }
 
 
 shared_ptr<const GradFile> DFTGrid_base::compute_xcgrad(shared_ptr<const XCFunc> func, shared_ptr<const Matrix> mat) const {
+  if (func->mgga())
+    throw runtime_error("Nuclear gradients with meta-GGA functionals are not implemented");
   auto out = make_shared<GradFile>(geom_->natom());
 
+  // only the points in the batches of this process are set
   unique_ptr<double[]> rho(new double[grid_->size()]);
   unique_ptr<double[]> sigma, rhox, rhoy, rhoz;
   if (!func->lda()) {
@@ -172,81 +217,87 @@ shared_ptr<const GradFile> DFTGrid_base::compute_xcgrad(shared_ptr<const XCFunc>
   }
   unique_ptr<double[]> vxc(new double[grid_->size()*(func->lda()?1:2)]);
 
-  vector<shared_ptr<const Matrix>> orb = compute_rho_sigma(func, mat, rho, sigma, rhox, rhoy, rhoz);
-
-  StaticDist dist(grid_->size(), min(resources__->max_num_threads()*100, grid_->size()));
-  vector<pair<size_t, size_t>> table = dist.atable();
-
-  TaskQueue<VxcTask> tasks(table.size());
-  for (auto& i : table) {
-    const size_t n = i.first;
-    tasks.emplace_back(i.second, rho.get()+n, (!func->lda() ? sigma.get()+n : nullptr),
-                            vxc.get()+n, (!func->lda() ? vxc.get()+n+grid_->size() : nullptr), func);
-  }
-  tasks.compute();
-
-  // in GGA, we need nabla^2 basis // TODO I guess this should be more efficient..
-  array<shared_ptr<Matrix>,6> grad2;
-  if (!func->lda())
-    grad2 = grid_->compute_grad2();
-
-  // loop over target atom
-  size_t offset = 0;
-  int n = 0;
-  for (auto& b : geom_->atoms()) {
-    shared_ptr<const Matrix> bmat = mat->cut(offset, offset+b->nbasis());
-    array<shared_ptr<const Matrix>,3> d1mat;
-    d1mat[0] = make_shared<const Matrix>(*bmat % *grid_->gradx()->cut(offset, offset+b->nbasis()));
-    d1mat[1] = make_shared<const Matrix>(*bmat % *grid_->grady()->cut(offset, offset+b->nbasis()));
-    d1mat[2] = make_shared<const Matrix>(*bmat % *grid_->gradz()->cut(offset, offset+b->nbasis()));
-
-    double sum[3] = {0.0};
-    for (size_t i = 0; i != grid_->size(); ++i) {
-      for (int x = 0; x != 3; ++x)
-        sum[x] += ddot_(mat->mdim(), d1mat[x]->element_ptr(0,i), 1, orb[0]->element_ptr(0,i), 1) * grid_->weight(i) * vxc[i];
-    }
-
-    if (!func->lda()) {
-      array<shared_ptr<const Matrix>,6> d2mat;
-      for (int i = 0; i != 6; ++i)
-        d2mat[i] = make_shared<const Matrix>(*bmat % *grad2[i]->cut(offset, offset+b->nbasis()));
-
-      unique_ptr<double[]> tmp2(new double[mat->mdim()]);
-      for (size_t i = 0; i != grid_->size(); ++i) {
-        // first term
-        fill_n(tmp2.get(), mat->mdim(), 0.0);
-        daxpy_(mat->mdim(), rhox[i], d2mat[0]->element_ptr(0,i), 1, tmp2.get(), 1);
-        daxpy_(mat->mdim(), rhoy[i], d2mat[1]->element_ptr(0,i), 1, tmp2.get(), 1);
-        daxpy_(mat->mdim(), rhoz[i], d2mat[3]->element_ptr(0,i), 1, tmp2.get(), 1);
-        sum[0] += ddot_(mat->mdim(), tmp2.get(), 1, orb[0]->element_ptr(0,i), 1) * grid_->weight(i) * (2*vxc[i+grid_->size()]);
-        fill_n(tmp2.get(), mat->mdim(), 0.0);
-        daxpy_(mat->mdim(), rhox[i], d2mat[1]->element_ptr(0,i), 1, tmp2.get(), 1);
-        daxpy_(mat->mdim(), rhoy[i], d2mat[2]->element_ptr(0,i), 1, tmp2.get(), 1);
-        daxpy_(mat->mdim(), rhoz[i], d2mat[4]->element_ptr(0,i), 1, tmp2.get(), 1);
-        sum[1] += ddot_(mat->mdim(), tmp2.get(), 1, orb[0]->element_ptr(0,i), 1) * grid_->weight(i) * (2*vxc[i+grid_->size()]);
-        fill_n(tmp2.get(), mat->mdim(), 0.0);
-        daxpy_(mat->mdim(), rhox[i], d2mat[3]->element_ptr(0,i), 1, tmp2.get(), 1);
-        daxpy_(mat->mdim(), rhoy[i], d2mat[4]->element_ptr(0,i), 1, tmp2.get(), 1);
-        daxpy_(mat->mdim(), rhoz[i], d2mat[5]->element_ptr(0,i), 1, tmp2.get(), 1);
-        sum[2] += ddot_(mat->mdim(), tmp2.get(), 1, orb[0]->element_ptr(0,i), 1) * grid_->weight(i) * (2*vxc[i+grid_->size()]);
-        // second term
-        fill_n(tmp2.get(), mat->mdim(), 0.0);
-        daxpy_(mat->mdim(), rhox[i], orb[1]->element_ptr(0,i), 1, tmp2.get(), 1);
-        daxpy_(mat->mdim(), rhoy[i], orb[2]->element_ptr(0,i), 1, tmp2.get(), 1);
-        daxpy_(mat->mdim(), rhoz[i], orb[3]->element_ptr(0,i), 1, tmp2.get(), 1);
+  mutex outmutex;
+  for_each_batch([&](const GridBatch& batch) {
+    shared_ptr<const Matrix> cmat = batch.gather(*mat);
+    vector<shared_ptr<const Matrix>> orb = compute_rho_sigma(func, batch, mat, rho, sigma, rhox, rhoy, rhoz);
+    func->compute_vxc(batch.size(), rho.get()+batch.offset(), (!func->lda() ? sigma.get()+batch.offset() : nullptr),
+                      vxc.get()+batch.offset(), (!func->lda() ? vxc.get()+batch.offset()+grid_->size() : nullptr));
+
+    // in GGA, we need nabla^2 basis
+    array<shared_ptr<Matrix>,6> grad2;
+    if (!func->lda())
+      grad2 = grid_->compute_grad2(batch);
+
+    vector<double> grad(3*geom_->natom(), 0.0);
+
+    // loop over target atom
+    int offset = 0;
+    for (int n = 0; n != geom_->natom(); ++n) {
+      const int nbasis = geom_->atoms(n)->nbasis();
+      int lo, hi;
+      tie(lo, hi) = batch.range(offset, offset+nbasis);
+      offset += nbasis;
+      if (lo == hi) continue;
+
+      shared_ptr<const Matrix> bmat = cmat->cut(lo, hi);
+      array<shared_ptr<const Matrix>,3> d1mat;
+      d1mat[0] = make_shared<const Matrix>(*bmat % *batch.gradx()->cut(lo, hi));
+      d1mat[1] = make_shared<const Matrix>(*bmat % *batch.grady()->cut(lo, hi));
+      d1mat[2] = make_shared<const Matrix>(*bmat % *batch.gradz()->cut(lo, hi));
+
+      double sum[3] = {0.0};
+      for (size_t j = 0; j != batch.size(); ++j) {
+        const size_t i = batch.offset() + j;
         for (int x = 0; x != 3; ++x)
-          sum[x] += ddot_(mat->mdim(), tmp2.get(), 1, d1mat[x]->element_ptr(0,i), 1) * grid_->weight(i) * (2*vxc[i+grid_->size()]);
+          sum[x] += ddot_(mat->mdim(), d1mat[x]->element_ptr(0,j), 1, orb[0]->element_ptr(0,j), 1) * grid_->weight(i) * vxc[i];
       }
-    }
 
-    out->element(0, n) += -4.0*sum[0];
-    out->element(1, n) += -4.0*sum[1];
-    out->element(2, n) += -4.0*sum[2];
+      if (!func->lda()) {
+        array<shared_ptr<const Matrix>,6> d2mat;
+        for (int i = 0; i != 6; ++i)
+          d2mat[i] = make_shared<const Matrix>(*bmat % *grad2[i]->cut(lo, hi));
+
+        unique_ptr<double[]> tmp2(new double[mat->mdim()]);
+        for (size_t j = 0; j != batch.size(); ++j) {
+          const size_t i = batch.offset() + j;
+          // first term
+          fill_n(tmp2.get(), mat->mdim(), 0.0);
+          daxpy_(mat->mdim(), rhox[i], d2mat[0]->element_ptr(0,j), 1, tmp2.get(), 1);
+          daxpy_(mat->mdim(), rhoy[i], d2mat[1]->element_ptr(0,j), 1, tmp2.get(), 1);
+          daxpy_(mat->mdim(), rhoz[i], d2mat[3]->element_ptr(0,j), 1, tmp2.get(), 1);
+          sum[0] += ddot_(mat->mdim(), tmp2.get(), 1, orb[0]->element_ptr(0,j), 1) * grid_->weight(i) * (2*vxc[i+grid_->size()]);
+          fill_n(tmp2.get(), mat->mdim(), 0.0);
+          daxpy_(mat->mdim(), rhox[i], d2mat[1]->element_ptr(0,j), 1, tmp2.get(), 1);
+          daxpy_(mat->mdim(), rhoy[i], d2mat[2]->element_ptr(0,j), 1, tmp2.get(), 1);
+          daxpy_(mat->mdim(), rhoz[i], d2mat[4]->element_ptr(0,j), 1, tmp2.get(), 1);
+          sum[1] += ddot_(mat->mdim(), tmp2.get(), 1, orb[0]->element_ptr(0,j), 1) * grid_->weight(i) * (2*vxc[i+grid_->size()]);
+          fill_n(tmp2.get(), mat->mdim(), 0.0);
+          daxpy_(mat->mdim(), rhox[i], d2mat[3]->element_ptr(0,j), 1, tmp2.get(), 1);
+          daxpy_(mat->mdim(), rhoy[i], d2mat[4]->element_ptr(0,j), 1, tmp2.get(), 1);
+          daxpy_(mat->mdim(), rhoz[i], d2mat[5]->element_ptr(0,j), 1, tmp2.get(), 1);
+          sum[2] += ddot_(mat->mdim(), tmp2.get(), 1, orb[0]->element_ptr(0,j), 1) * grid_->weight(i) * (2*vxc[i+grid_->size()]);
+          // second term
+          fill_n(tmp2.get(), mat->mdim(), 0.0);
+          daxpy_(mat->mdim(), rhox[i], orb[1]->element_ptr(0,j), 1, tmp2.get(), 1);
+          daxpy_(mat->mdim(), rhoy[i], orb[2]->element_ptr(0,j), 1, tmp2.get(), 1);
+          daxpy_(mat->mdim(), rhoz[i], orb[3]->element_ptr(0,j), 1, tmp2.get(), 1);
+          for (int x = 0; x != 3; ++x)
+            sum[x] += ddot_(mat->mdim(), tmp2.get(), 1, d1mat[x]->element_ptr(0,j), 1) * grid_->weight(i) * (2*vxc[i+grid_->size()]);
+        }
+      }
+      for (int x = 0; x != 3; ++x)
+        grad[x+3*n] += sum[x];
+    }
 
-    offset += b->nbasis();
-    ++n;
-  }
+    lock_guard<mutex> lock(outmutex);
+    for (int i = 0; i != geom_->natom(); ++i)
+      for (int x = 0; x != 3; ++x)
+        out->element(x, i) += -4.0*grad[x+3*i];
+  });
 
+  // sum over the batches of all the processes
+  out->allreduce();
   return out;
 }
 
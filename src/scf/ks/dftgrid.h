@@ -25,6 +25,7 @@
 #ifndef __SRC_KS_DFTGRID_H
 #define __SRC_KS_DFTGRID_H
 
+#include <functional>
 #include <src/scf/ks/xcfunc.h>
 #include <src/scf/ks/grid.h>
 
@@ -42,9 +43,15 @@ class DFTGrid_base {
                   const std::unique_ptr<double[]>& x, const std::unique_ptr<double[]>& y, const std::unique_ptr<double[]>& z, const std::unique_ptr<double[]>& w);
     void remove_redgrid();
 
-    std::vector<std::shared_ptr<const Matrix>> compute_rho_sigma(std::shared_ptr<const XCFunc> func, std::shared_ptr<const Matrix> mat,
+    // orbitals (and their gradients for GGA) on the points of a batch. rho, sigma, and rho gradients are set at these points
+    std::vector<std::shared_ptr<const Matrix>> compute_rho_sigma(std::shared_ptr<const XCFunc> func, const GridBatch& batch, std::shared_ptr<const Matrix> mat,
                                                     std::unique_ptr<double[]>& rho, std::unique_ptr<double[]>& sigma,
                                                     std::unique_ptr<double[]>& rhox, std::unique_ptr<double[]>& rhoy, std::unique_ptr<double[]>& rhoz) const;
+    // kinetic energy density (and the Laplacian of the density if blapl is given) on the points of a batch for meta-GGA
+    void compute_tau_lapl(const GridBatch& batch, std::shared_ptr<const Matrix> mat, const std::vector<std::shared_ptr<const Matrix>>& orb,
+                          std::shared_ptr<const Matrix> blapl, std::unique_ptr<double[]>& tau, std::unique_ptr<double[]>& lapl) const;
+    // calls f for each of the batches (that have significant basis functions) in parallel
+    void for_each_batch(std::function<void(const GridBatch&)> f) const;
   public:
     DFTGrid_base(std::shared_ptr<const Geometry> geom) : geom_(geom) { }
 
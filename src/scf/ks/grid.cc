@@ -22,101 +22,196 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <numeric>
+#include <functional>
 #include <src/scf/ks/grid.h>
 #include <src/util/parallel/resources.h>
+#include <src/util/parallel/mpi_interface.h>
+
+using namespace std;
+using namespace bagel;
 
 namespace bagel {
-class GridBasisTask {
+class GridBatchTask {
   protected:
-    double* const a;
-    double* const b;
-    double* const c;
-    double* const d;
-    const double x;
-    const double y;
-    const double z;
-    std::shared_ptr<const Geometry> geom_;
+    shared_ptr<GridBatch> batch_;
+    const Matrix& data_;
   public:
-    GridBasisTask(double* aa, double* bb, double* cc, double* dd, const double xx, const double yy, const double zz, std::shared_ptr<const Geometry> g)
-    : a(aa), b(bb), c(cc), d(dd), x(xx), y(yy), z(zz), geom_(g) { }
-    void compute() {
-      int pos = 0;
-      for (auto& i : geom_->atoms()) {
-        // xyz coordinate relative to the atom i
-        const double rx = x - i->position(0);
-        const double ry = y - i->position(1);
-        const double rz = z - i->position(2);
-        for (auto& j : i->shells()) {
-          j->compute_grid_value(a+pos, b+pos, c+pos, d+pos, rx, ry, rz);
-          pos += j->nbasis();
-        }
-      }
-    }
+    GridBatchTask(shared_ptr<GridBatch> b, const Matrix& d) : batch_(b), data_(d) { }
+    void compute() { batch_->init(data_); }
+    double cost() const { return static_cast<double>(batch_->nbasis())*batch_->size(); }
 };
-class GridDeriv2Task {
-  protected:
-    double* const a;
-    double* const b;
-    double* const c;
-    double* const d;
-    double* const e;
-    double* const f;
-    const double x;
-    const double y;
-    const double z;
-    std::shared_ptr<const Geometry> geom_;
-  public:
-    GridDeriv2Task(double* aa, double* bb, double* cc, double* dd, double* ee, double* ff,
-                   const double xx, const double yy, const double zz, std::shared_ptr<const Geometry> g)
-    : a(aa), b(bb), c(cc), d(dd), e(ee), f(ff), x(xx), y(yy), z(zz), geom_(g) { }
-    void compute() {
-      int pos = 0;
-      for (auto& i : geom_->atoms()) {
-        // xyz coordinate relative to the atom i
-        const double rx = x - i->position(0);
-        const double ry = y - i->position(1);
-        const double rz = z - i->position(2);
-        for (auto& j : i->shells()) {
-          j->compute_grid_value_deriv2(a+pos, b+pos, c+pos, d+pos, e+pos, f+pos, rx, ry, rz);
-          pos += j->nbasis();
-        }
-      }
+}
+
+
+GridBatch::GridBatch(const size_t offset, const size_t size, vector<pair<shared_ptr<const Shell>, int>>&& shells)
+ : offset_(offset), size_(size), shells_(move(shells)) {
+  for (auto& i : shells_)
+    for (int j = 0; j != i.first->nbasis(); ++j)
+      index_.push_back(i.second + j);
+}
+
+
+pair<int, int> GridBatch::range(const int start, const int fence) const {
+  return {lower_bound(index_.begin(), index_.end(), start) - index_.begin(), lower_bound(index_.begin(), index_.end(), fence) - index_.begin()};
+}
+
+
+shared_ptr<Matrix> GridBatch::gather(const Matrix& mat) const {
+  auto out = make_shared<Matrix>(nbasis(), mat.mdim());
+  for (int j = 0; j != mat.mdim(); ++j) {
+    double* target = out->element_ptr(0, j);
+    for (auto& i : shells_)
+      target = copy_n(mat.element_ptr(i.second, j), i.first->nbasis(), target);
+  }
+  return out;
+}
+
+
+void GridBatch::scatter_add(const Matrix& in, Matrix& out) const {
+  assert(in.ndim() == nbasis() && in.mdim() == nbasis());
+  for (int j = 0; j != nbasis(); ++j) {
+    const double* source = in.element_ptr(0, j);
+    for (auto& i : shells_) {
+      double* target = out.element_ptr(i.second, index_[j]);
+      for (int k = 0; k != i.first->nbasis(); ++k)
+        target[k] += source[k];
+      source += i.first->nbasis();
     }
-};
+  }
 }
 
 
-using namespace std;
-using namespace bagel;
+void GridBatch::init(const Matrix& data) {
+  basis_ = make_shared<Matrix>(nbasis(), size_);
+  gradx_ = make_shared<Matrix>(nbasis(), size_);
+  grady_ = make_shared<Matrix>(nbasis(), size_);
+  gradz_ = make_shared<Matrix>(nbasis(), size_);
 
-void Grid::init() {
-  const int ngrid = size();
-  basis_ = make_shared<Matrix>(geom_->nbasis(), ngrid);
-  gradx_ = make_shared<Matrix>(geom_->nbasis(), ngrid);
-  grady_ = make_shared<Matrix>(geom_->nbasis(), ngrid);
-  gradz_ = make_shared<Matrix>(geom_->nbasis(), ngrid);
-
-  // TODO I guess this should be more efficient..
-  TaskQueue<GridBasisTask> tasks(ngrid);
-  for (size_t g = 0; g != ngrid; ++g) {
-    tasks.emplace_back(basis_->element_ptr(0,g), gradx_->element_ptr(0,g), grady_->element_ptr(0,g), gradz_->element_ptr(0,g),
-                                  data_->element(0,g), data_->element(1,g), data_->element(2,g), geom_);
+  for (size_t g = 0; g != size_; ++g) {
+    const double* xyz = data.element_ptr(0, offset_+g);
+    int pos = 0;
+    for (auto& i : shells_) {
+      // xyz coordinate relative to the center of the shell
+      i.first->compute_grid_value(basis_->element_ptr(pos, g), gradx_->element_ptr(pos, g), grady_->element_ptr(pos, g), gradz_->element_ptr(pos, g),
+                                  xyz[0]-i.first->position(0), xyz[1]-i.first->position(1), xyz[2]-i.first->position(2));
+      pos += i.first->nbasis();
+    }
   }
-  tasks.compute();
 }
 
 
-array<shared_ptr<Matrix>,6> Grid::compute_grad2() const {
+array<shared_ptr<Matrix>,6> GridBatch::compute_grad2(const Matrix& data) const {
   array<shared_ptr<Matrix>,6> out;
   for (auto& i : out)
-   i = make_shared<Matrix>(geom_->nbasis(), size());
+    i = make_shared<Matrix>(nbasis(), size_);
 
-  TaskQueue<GridDeriv2Task> tasks(size());
-  for (size_t g = 0; g != size(); ++g) {
-    tasks.emplace_back(out[0]->element_ptr(0,g), out[1]->element_ptr(0,g), out[2]->element_ptr(0,g),
-                                   out[3]->element_ptr(0,g), out[4]->element_ptr(0,g), out[5]->element_ptr(0,g),
-                                   data_->element(0,g), data_->element(1,g), data_->element(2,g), geom_);
+  for (size_t g = 0; g != size_; ++g) {
+    const double* xyz = data.element_ptr(0, offset_+g);
+    int pos = 0;
+    for (auto& i : shells_) {
+      i.first->compute_grid_value_deriv2(out[0]->element_ptr(pos, g), out[1]->element_ptr(pos, g), out[2]->element_ptr(pos, g),
+                                         out[3]->element_ptr(pos, g), out[4]->element_ptr(pos, g), out[5]->element_ptr(pos, g),
+                                         xyz[0]-i.first->position(0), xyz[1]-i.first->position(1), xyz[2]-i.first->position(2));
+      pos += i.first->nbasis();
+    }
   }
-  tasks.compute();
   return out;
 }
+
+
+void Grid::init() {
+  const size_t ngrid = size();
+
+  // points are split into batches by recursive bisection along the longest edge of their bounding box
+  vector<size_t> order(ngrid);
+  iota(order.begin(), order.end(), 0);
+  vector<pair<size_t, size_t>> ranges;
+  function<void(const size_t, const size_t)> bisect = [&](const size_t lo, const size_t hi) {
+    if (hi - lo <= max_batch_) {
+      ranges.emplace_back(lo, hi);
+      return;
+    }
+    array<double,3> xmin, xmax;
+    xmin.fill(numeric_limits<double>::max());
+    xmax.fill(-numeric_limits<double>::max());
+    for (size_t g = lo; g != hi; ++g)
+      for (int k = 0; k != 3; ++k) {
+        xmin[k] = min(xmin[k], data_->element(k, order[g]));
+        xmax[k] = max(xmax[k], data_->element(k, order[g]));
+      }
+    int axis = 0;
+    for (int k = 1; k != 3; ++k)
+      if (xmax[k]-xmin[k] > xmax[axis]-xmin[axis]) axis = k;
+    const size_t mid = (lo + hi) / 2;
+    nth_element(order.begin()+lo, order.begin()+mid, order.begin()+hi,
+                [&](const size_t a, const size_t b) { return data_->element(axis, a) < data_->element(axis, b); });
+    bisect(lo, mid);
+    bisect(mid, hi);
+  };
+  if (ngrid)
+    bisect(0, ngrid);
+
+  auto sorted = make_shared<Matrix>(4, ngrid);
+  for (size_t g = 0; g != ngrid; ++g)
+    copy_n(data_->element_ptr(0, order[g]), 4, sorted->element_ptr(0, g));
+  data_ = sorted;
+
+  // radial extent of each shell
+  vector<tuple<shared_ptr<const Shell>, int, double>> shells;
+  int offset = 0;
+  for (auto& i : geom_->atoms())
+    for (auto& j : i->shells()) {
+      shells.emplace_back(j, offset, j->extent(screen_thresh_));
+      offset += j->nbasis();
+    }
+
+  vector<shared_ptr<GridBatch>> batches;
+  for (auto& r : ranges) {
+    // the sphere that contains all the points in this batch
+    array<double,3> xmin, xmax, center;
+    xmin.fill(numeric_limits<double>::max());
+    xmax.fill(-numeric_limits<double>::max());
+    for (size_t g = r.first; g != r.second; ++g)
+      for (int k = 0; k != 3; ++k) {
+        xmin[k] = min(xmin[k], data_->element(k, g));
+        xmax[k] = max(xmax[k], data_->element(k, g));
+      }
+    for (int k = 0; k != 3; ++k)
+      center[k] = 0.5*(xmin[k] + xmax[k]);
+    double radius = 0.0;
+    for (size_t g = r.first; g != r.second; ++g)
+      radius = max(radius, sqrt(pow(data_->element(0, g)-center[0], 2) + pow(data_->element(1, g)-center[1], 2) + pow(data_->element(2, g)-center[2], 2)));
+
+    vector<pair<shared_ptr<const Shell>, int>> significant;
+    for (auto& s : shells) {
+      const array<double,3>& pos = get<0>(s)->position();
+      const double dist = sqrt(pow(pos[0]-center[0], 2) + pow(pos[1]-center[1], 2) + pow(pos[2]-center[2], 2));
+      if (dist - radius < get<2>(s))
+        significant.emplace_back(get<0>(s), get<1>(s));
+    }
+    // batches on which no function is significant do not contribute
+    if (!significant.empty())
+      batches.push_back(make_shared<GridBatch>(r.first, r.second-r.first, move(significant)));
+  }
+
+  // batches are distributed to the processes, starting from the most expensive one, to the one with the smallest load so far.
+  // Every process makes the same assignment and keeps its own batches.
+  vector<size_t> border(batches.size());
+  iota(border.begin(), border.end(), 0);
+  auto cost = [&](const size_t i) { return static_cast<double>(batches[i]->nbasis())*batches[i]->size(); };
+  stable_sort(border.begin(), border.end(), [&](const size_t a, const size_t b) { return cost(a) > cost(b); });
+  vector<double> load(mpi__->size(), 0.0);
+  batches_.clear();
+  for (auto& i : border) {
+    const int rank = min_element(load.begin(), load.end()) - load.begin();
+    load[rank] += cost(i);
+    if (rank == mpi__->rank())
+      batches_.push_back(batches[i]);
+  }
+
+  TaskQueue<GridBatchTask> tasks(batches_.size());
+  for (auto& i : batches_)
+    tasks.emplace_back(i, *data_);
+  tasks.compute();
+}
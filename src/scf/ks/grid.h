@@ -32,30 +32,79 @@
 
 namespace bagel {
 
-class Grid {
+// A spatially compact batch of grid points, together with the basis functions that are significant on them
+class GridBatch {
   protected:
-    const std::shared_ptr<const Geometry> geom_;
-    const std::shared_ptr<const Matrix> data_; // x,y,z,weight
+    // range of the points in Grid
+    const size_t offset_;
+    const size_t size_;
+
+    // significant shells and their offsets in the AO basis; the functions are stored in this order
+    std::vector<std::pair<std::shared_ptr<const Shell>, int>> shells_;
+    // AO index of each of the significant functions
+    std::vector<int> index_;
 
-    // basis functions and derivaties on this grid
+    // basis functions and derivaties on the points in this batch (significant functions only)
     std::shared_ptr<Matrix> basis_;
     std::shared_ptr<Matrix> gradx_;
     std::shared_ptr<Matrix> grady_;
     std::shared_ptr<Matrix> gradz_;
 
   public:
-    Grid(std::shared_ptr<const Geometry> g, std::shared_ptr<const Matrix>& o)
-      : geom_(g), data_(o) { assert(data_->ndim() == 4); }
+    GridBatch(const size_t offset, const size_t size, std::vector<std::pair<std::shared_ptr<const Shell>, int>>&& shells);
+
+    size_t offset() const { return offset_; }
+    size_t size() const { return size_; }
+    int nbasis() const { return index_.size(); }
+    const std::vector<int>& index() const { return index_; }
 
     std::shared_ptr<const Matrix> basis() const { return basis_; }
     std::shared_ptr<const Matrix> gradx() const { return gradx_; }
     std::shared_ptr<const Matrix> grady() const { return grady_; }
     std::shared_ptr<const Matrix> gradz() const { return gradz_; }
+
+    // rows of the significant functions whose AO indices are in [start, fence)
+    std::pair<int, int> range(const int start, const int fence) const;
+    // rows of an AO matrix that correspond to the significant functions
+    std::shared_ptr<Matrix> gather(const Matrix& mat) const;
+    // adds a matrix in the significant functions to an AO matrix
+    void scatter_add(const Matrix& in, Matrix& out) const;
+
+    void init(const Matrix& data);
+    std::array<std::shared_ptr<Matrix>,6> compute_grad2(const Matrix& data) const;
+};
+
+
+class Grid {
+  protected:
+    const std::shared_ptr<const Geometry> geom_;
+    std::shared_ptr<const Matrix> data_; // x,y,z,weight
+
+    // batches of grid points assigned to this process; the points are reordered by init() so that each batch is contiguous
+    std::vector<std::shared_ptr<GridBatch>> batches_;
+
+    // the maximum number of points in a batch
+    constexpr static size_t max_batch_ = 128;
+    // basis functions whose values (and derivatives) are below this on all the points of a batch are skipped
+    constexpr static double screen_thresh_ = 1.0e-12;
+
+  public:
+    Grid(std::shared_ptr<const Geometry> g, std::shared_ptr<const Matrix>& o)
+      : geom_(g), data_(o) { assert(data_->ndim() == 4); }
+
+    const std::vector<std::shared_ptr<GridBatch>>& batches() const { return batches_; }
     const double& weight(const size_t i) const { return data_->element(3,i); }
     size_t size() const { return data_->mdim(); }
     std::shared_ptr<const Matrix> data() const { return data_; }
 
-    std::array<std::shared_ptr<Matrix>,6> compute_grad2() const;
+    std::array<std::shared_ptr<Matrix>,6> compute_grad2(const GridBatch& batch) const { return batch.compute_grad2(*data_); }
+    // Laplacian of the basis functions (xx + yy + zz)
+    std::shared_ptr<Matrix> compute_laplacian(const GridBatch& batch) const {
+      std::array<std::shared_ptr<Matrix>,6> grad2 = compute_grad2(batch);
+      *grad2[0] += *grad2[2];
+      *grad2[0] += *grad2[5];
+      return grad2[0];
+    }
 
     void init();
 
@@ -24,6 +24,7 @@
 
 #include <src/scf/ks/ks.h>
 #include <src/scf/hf/fock.h>
+#include <src/integral/rys/eribatch.h>
 #include <src/prop/multipole.h>
 #include <src/util/math/diis.h>
 
@@ -45,6 +46,19 @@ void KS::compute() {
 
   DIIS<Matrix> diis(diis_size_);
 
+  // range-separated hybrids: DF integrals of erf(omega r)/r, fitted with the attenuated metric, for the long-range exchange
+  shared_ptr<const DFDist> dferf;
+  if (func_->omega() != 0.0) {
+#ifdef LIBINT_INTERFACE
+    throw runtime_error("Range-separated functionals are not available with the libint interface");
+#else
+    Timer erftime;
+    dferf = geom_->form_fit<DFDist_ints<ERIBatch>>(geom_->overlap_thresh(), true, func_->omega());
+    erftime.tick_print("attenuated 3-index integrals");
+    cout << endl;
+#endif
+  }
+
   shared_ptr<Matrix> fock;
 
   Timer scftime;
@@ -52,6 +66,10 @@ void KS::compute() {
 
     // fock operator without DFT xc
     fock = make_shared<Fock<1>>(geom_, hcore_, aodensity_, coeff_->slice(0, nocc_), false /*store*/, true /*rhf*/, func_->scale_ex());
+    if (dferf) {
+      shared_ptr<const DFHalfDist> half = dferf->compute_half_transform(coeff_->slice(0, nocc_))->apply_J();
+      *fock += *half->form_2index(half, -1.0*func_->scale_ex_lr());
+    }
 
     // add xc
     shared_ptr<const Matrix> xc;
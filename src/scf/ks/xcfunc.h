@@ -50,6 +50,21 @@ class FuncList {
       map_.emplace("pbec",      XC_GGA_C_PBE);
       map_.emplace("b3lyp",     XC_HYB_GGA_XC_B3LYP);
       map_.emplace("pbe0",      XC_HYB_GGA_XC_PBEH);
+      // range-separated hybrids
+      map_.emplace("camb3lyp",  XC_HYB_GGA_XC_CAM_B3LYP);
+      map_.emplace("wb97",      XC_HYB_GGA_XC_WB97);
+      map_.emplace("wb97x",     XC_HYB_GGA_XC_WB97X);
+      map_.emplace("lcwpbe",    XC_HYB_GGA_XC_LRC_WPBE);
+      // meta-GGAs
+      map_.emplace("tpssx",     XC_MGGA_X_TPSS);
+      map_.emplace("tpssc",     XC_MGGA_C_TPSS);
+      map_.emplace("m06lx",     XC_MGGA_X_M06_L);
+      map_.emplace("m06lc",     XC_MGGA_C_M06_L);
+      map_.emplace("tpssh",     XC_HYB_MGGA_XC_TPSSH);
+#ifdef XC_MGGA_X_SCAN
+      map_.emplace("scanx",     XC_MGGA_X_SCAN);
+      map_.emplace("scanc",     XC_MGGA_C_SCAN);
+#endif
     }
     int num(const std::string& name) const {
       auto iter = map_.find(name);
@@ -79,24 +94,45 @@ class XCFunc {
       } else if (gga()) {
         xc_gga_exc_vxc(&func_, np, rho, sigma, exc, vxc, vxc2);
       } else {
-        throw std::runtime_error("Meta GGA not supported yet");
+        throw std::runtime_error("Meta GGA requires the kinetic energy density");
       }
     }
 
+    // meta-GGA; lapl is referenced only when need_laplacian() is true
+    void compute_exc_vxc(int np, const double* rho, const double* sigma, const double* lapl, const double* tau,
+                         double* exc, double* vxc, double* vxc2, double* vlapl, double* vtau) const {
+      if (!mgga())
+        compute_exc_vxc(np, rho, sigma, exc, vxc, vxc2);
+      else
+        xc_mgga_exc_vxc(&func_, np, rho, sigma, lapl, tau, exc, vxc, vxc2, vlapl, vtau);
+    }
+
     void compute_vxc(int np, const double* rho, const double* sigma, double* vxc, double* vxc2) const {
       if (lda()) {
         xc_lda_vxc(&func_, np, rho, vxc);
       } else if (gga()) {
         xc_gga_vxc(&func_, np, rho, sigma, vxc, vxc2);
       } else {
-        throw std::runtime_error("Meta GGA not supported yet");
+        throw std::runtime_error("Meta GGA requires the kinetic energy density");
       }
     }
 
     bool lda() const { return func_.info->family == XC_FAMILY_LDA; }
     bool gga() const { return func_.info->family == XC_FAMILY_HYB_GGA || func_.info->family == XC_FAMILY_GGA; }
+    bool mgga() const { return func_.info->family == XC_FAMILY_HYB_MGGA || func_.info->family == XC_FAMILY_MGGA; }
+    bool hybrid() const { return func_.info->family == XC_FAMILY_HYB_GGA || func_.info->family == XC_FAMILY_HYB_MGGA; }
+#ifdef XC_FLAGS_NEEDS_LAPLACIAN
+    bool need_laplacian() const { return mgga() && (func_.info->flags & XC_FLAGS_NEEDS_LAPLACIAN); }
+#else
+    bool need_laplacian() const { return mgga(); }
+#endif
 
-    double scale_ex() const { return (func_.info->family == XC_FAMILY_HYB_GGA) ? xc_hyb_exx_coef(&func_) : 0.0; }
+    // exact exchange is alpha*K + beta*K_sr(omega) = (alpha+beta)*K - beta*K_erf(omega) in libxc
+    double omega() const { double o = 0.0, a = 0.0, b = 0.0; if (hybrid()) xc_hyb_cam_coef(&func_, &o, &a, &b); return o; }
+    // the coefficient of the full-range exchange
+    double scale_ex() const { double o = 0.0, a = 0.0, b = 0.0; if (hybrid()) xc_hyb_cam_coef(&func_, &o, &a, &b); return a + b; }
+    // the coefficient of the erf-attenuated (long-range) exchange
+    double scale_ex_lr() const { double o = 0.0, a = 0.0, b = 0.0; if (hybrid()) xc_hyb_cam_coef(&func_, &o, &a, &b); return o != 0.0 ? -b : 0.0; }
 };
 
 #else
@@ -104,9 +140,15 @@ class XCFunc {
 public:
   XCFunc(const std::string) { assert(false); }
   void compute_exc_vxc(int np, const double* rho, const double* sigma, double* exc, double* vxc, double* vxc2) const {}
+  void compute_exc_vxc(int np, const double* rho, const double* sigma, const double* lapl, const double* tau,
+                       double* exc, double* vxc, double* vxc2, double* vlapl, double* vtau) const {}
   void compute_vxc(int np, const double* rho, const double* sigma, double* vxc, double* vxc2) const {}
   bool lda() const { return true; }
+  bool mgga() const { return false; }
+  bool need_laplacian() const { return false; }
+  double omega() const { return 0.0; }
   double scale_ex() const { return 0.0; }
+  double scale_ex_lr() const { return 0.0; }
 }; // dummy
 #endif
 
@@ -60,6 +60,15 @@ SCF_base_<MatType, OvlType, HcType, Enable>::SCF_base_(shared_ptr<const PTree> i
   thresh_overlap_ = idata_->get<double>("thresh_overlap", 1.0e-8);
   thresh_scf_ = idata_->get<double>("thresh", 1.0e-8);
   thresh_scf_ = idata_->get<double>("thresh_scf", thresh_scf_);
+  thresh_exchange_ = idata_->get<double>("thresh_exchange", 0.0);
+
+  // Fock matrices are built from density changes in direct SCF (the methods that request the Schwarz matrix);
+  // a full build is performed every fock_reset_ iterations
+  fock_reset_ = idata_->get<int>("fock_reset", 10);
+  if (idata_->get_child_optional("fock_reset") && (!need_schwarz || dofmm_))
+    throw runtime_error("fock_reset is only used in direct SCF without density fitting or FMM");
+  if (fock_reset_ < 1)
+    throw runtime_error("fock_reset should be a positive integer");
 
   if (dofmm_) {
     fmm_ = make_shared<const FMM>(idata_, geom);
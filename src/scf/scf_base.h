@@ -51,6 +51,10 @@ class SCF_base_ : public Method {
 
     double thresh_overlap_;
     double thresh_scf_;
+    // screening threshold for the DF exchange build with localized orbitals (0 means no screening)
+    double thresh_exchange_;
+    // number of iterations between full (non-incremental) Fock builds in direct SCF
+    int fock_reset_;
     int multipole_print_;
     int dma_print_;
 
@@ -87,7 +91,7 @@ class SCF_base_ : public Method {
     void serialize(Archive& ar, const unsigned int) {
       ar & boost::serialization::base_object<Method>(*this);
       ar & tildex_ & overlap_ & hcore_ & coeff_ & max_iter_ & diis_start_ & diis_size_
-         & thresh_overlap_ & thresh_scf_ & multipole_print_ & dma_print_ & schwarz_ & eig_ & energy_
+         & thresh_overlap_ & thresh_scf_ & thresh_exchange_ & fock_reset_ & multipole_print_ & dma_print_ & schwarz_ & eig_ & energy_
          & nocc_ & noccB_ & do_grad_ & restart_ & dofmm_ & fmm_ & fmmK_;
     }
 
@@ -111,6 +115,7 @@ class SCF_base_ : public Method {
 
     double thresh_overlap() const { return thresh_overlap_; }
     double thresh_scf() const { return thresh_scf_; }
+    double thresh_exchange() const { return thresh_exchange_; }
 
     virtual std::shared_ptr<const Reference> conv_to_ref() const override = 0;
 
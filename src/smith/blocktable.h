@@ -0,0 +1,104 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: blocktable.h
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// Open-addressing hash table that relates block keys to storage records.
+// The table is built once when a storage object is set up and is only read afterwards,
+// so we use linear probing on a power-of-two table and never erase entries.
+
+#ifndef __SRC_SMITH_BLOCKTABLE_H
+#define __SRC_SMITH_BLOCKTABLE_H
+
+#include <vector>
+#include <limits>
+#include <cassert>
+#include <utility>
+
+namespace bagel {
+namespace SMITH {
+
+template<typename T>
+class BlockTable {
+  public:
+    using value_type = std::pair<size_t, T>;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  protected:
+    // entries in the order of insertion
+    std::vector<value_type> entries_;
+    // slots hold position in entries_ + 1; zero means empty
+    std::vector<size_t> slots_;
+    size_t mask_;
+    int bits_;
+
+    // Fibonacci hashing: the keys are packed block indices whose low bits are strongly correlated
+    size_t slot(const size_t key) const { return (key * 0x9E3779B97F4A7C15lu) >> (std::numeric_limits<size_t>::digits - bits_); }
+
+    void rehash(const int bits) {
+      bits_ = bits;
+      slots_.assign(1lu << bits_, 0lu);
+      mask_ = slots_.size() - 1;
+      for (size_t n = 0; n != entries_.size(); ++n) {
+        size_t i = slot(entries_[n].first);
+        while (slots_[i]) i = (i+1) & mask_;
+        slots_[i] = n+1;
+      }
+    }
+
+  public:
+    BlockTable() { rehash(4); }
+
+    // returns false if the key is already present (as in std::unordered_map::emplace)
+    bool emplace(const size_t key, const T& value) {
+      if (find(key) != end())
+        return false;
+      // keep the load factor below 1/2
+      if (2*(entries_.size()+1) > slots_.size())
+        rehash(bits_+1);
+      entries_.emplace_back(key, value);
+      size_t i = slot(key);
+      while (slots_[i]) i = (i+1) & mask_;
+      slots_[i] = entries_.size();
+      return true;
+    }
+    bool emplace(const value_type& p) { return emplace(p.first, p.second); }
+
+    const_iterator find(const size_t key) const {
+      for (size_t i = slot(key); slots_[i]; i = (i+1) & mask_)
+        if (entries_[slots_[i]-1].first == key)
+          return entries_.begin() + (slots_[i]-1);
+      return entries_.end();
+    }
+
+    size_t count(const size_t key) const { return find(key) != end() ? 1lu : 0lu; }
+
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+};
+
+}
+}
+
+#endif
@@ -58,7 +58,7 @@ class Task0 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task0(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -85,7 +85,7 @@ class Task1 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task1(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -112,7 +112,7 @@ class Task2 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task2(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -139,7 +139,7 @@ class Task3 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task3(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -166,7 +166,7 @@ class Task4 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task4(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -193,7 +193,7 @@ class Task5 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task5(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -220,7 +220,7 @@ class Task6 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task6(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -247,7 +247,7 @@ class Task7 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task7(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -274,7 +274,7 @@ class Task8 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task8(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -301,7 +301,7 @@ class Task9 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task9(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -328,7 +328,7 @@ class Task10 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task10(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -355,7 +355,7 @@ class Task11 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task11(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -382,7 +382,7 @@ class Task12 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task12(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -409,7 +409,7 @@ class Task13 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task13(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -436,7 +436,7 @@ class Task14 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task14(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -463,7 +463,7 @@ class Task15 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task15(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -490,7 +490,7 @@ class Task16 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task16(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -517,7 +517,7 @@ class Task17 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task17(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -544,7 +544,7 @@ class Task18 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task18(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -571,7 +571,7 @@ class Task19 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task19(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -598,7 +598,7 @@ class Task20 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task20(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -625,7 +625,7 @@ class Task21 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task21(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -652,7 +652,7 @@ class Task22 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task22(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -679,7 +679,7 @@ class Task23 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task23(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -706,7 +706,7 @@ class Task24 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task24(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -733,7 +733,7 @@ class Task25 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task25(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -760,7 +760,7 @@ class Task26 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task26(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -787,7 +787,7 @@ class Task27 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task27(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -814,7 +814,7 @@ class Task28 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task28(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -841,7 +841,7 @@ class Task29 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task29(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -868,7 +868,7 @@ class Task30 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task30(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -895,7 +895,7 @@ class Task31 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task31(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -922,7 +922,7 @@ class Task32 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task32(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -949,7 +949,7 @@ class Task33 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task33(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -976,7 +976,7 @@ class Task34 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task34(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1003,7 +1003,7 @@ class Task35 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task35(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1030,7 +1030,7 @@ class Task36 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task36(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1057,7 +1057,7 @@ class Task37 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task37(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1084,7 +1084,7 @@ class Task38 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task38(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1111,7 +1111,7 @@ class Task39 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task39(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1155,7 +1155,7 @@ class Task41 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task41(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1184,7 +1184,7 @@ class Task42 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task42(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1213,7 +1213,7 @@ class Task43 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task43(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1242,7 +1242,7 @@ class Task44 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task44(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1271,7 +1271,7 @@ class Task45 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task45(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1300,7 +1300,7 @@ class Task46 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task46(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1329,7 +1329,7 @@ class Task47 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task47(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1358,7 +1358,7 @@ class Task48 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task48(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1387,7 +1387,7 @@ class Task49 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task49(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
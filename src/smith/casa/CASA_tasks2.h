@@ -60,7 +60,7 @@ class Task50 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task50(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -89,7 +89,7 @@ class Task51 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task51(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -118,7 +118,7 @@ class Task52 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task52(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -147,7 +147,7 @@ class Task53 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task53(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -176,7 +176,7 @@ class Task54 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task54(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -205,7 +205,7 @@ class Task55 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task55(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -234,7 +234,7 @@ class Task56 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task56(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -263,7 +263,7 @@ class Task57 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task57(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -292,7 +292,7 @@ class Task58 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task58(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -322,7 +322,7 @@ class Task59 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task59(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range, const double e);
@@ -351,7 +351,7 @@ class Task60 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task60(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -380,7 +380,7 @@ class Task61 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task61(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -409,7 +409,7 @@ class Task62 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task62(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -438,7 +438,7 @@ class Task63 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task63(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -467,7 +467,7 @@ class Task64 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task64(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -496,7 +496,7 @@ class Task65 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task65(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -525,7 +525,7 @@ class Task66 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task66(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -554,7 +554,7 @@ class Task67 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task67(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -583,7 +583,7 @@ class Task68 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task68(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -612,7 +612,7 @@ class Task69 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task69(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -641,7 +641,7 @@ class Task70 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task70(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -670,7 +670,7 @@ class Task71 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task71(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -699,7 +699,7 @@ class Task72 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task72(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -728,7 +728,7 @@ class Task73 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task73(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -757,7 +757,7 @@ class Task74 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task74(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -786,7 +786,7 @@ class Task75 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task75(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -815,7 +815,7 @@ class Task76 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task76(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -844,7 +844,7 @@ class Task77 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task77(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -873,7 +873,7 @@ class Task78 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task78(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -902,7 +902,7 @@ class Task79 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task79(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -931,7 +931,7 @@ class Task80 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task80(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -960,7 +960,7 @@ class Task81 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task81(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -989,7 +989,7 @@ class Task82 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task82(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1018,7 +1018,7 @@ class Task83 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task83(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1047,7 +1047,7 @@ class Task84 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task84(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1076,7 +1076,7 @@ class Task85 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task85(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1105,7 +1105,7 @@ class Task86 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task86(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1134,7 +1134,7 @@ class Task87 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task87(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1163,7 +1163,7 @@ class Task88 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task88(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1192,7 +1192,7 @@ class Task89 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task89(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1222,7 +1222,7 @@ class Task90 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task90(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range, const double e);
@@ -1251,7 +1251,7 @@ class Task91 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task91(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1280,7 +1280,7 @@ class Task92 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task92(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1309,7 +1309,7 @@ class Task93 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task93(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1338,7 +1338,7 @@ class Task94 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task94(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1367,7 +1367,7 @@ class Task95 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task95(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1396,7 +1396,7 @@ class Task96 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task96(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1425,7 +1425,7 @@ class Task97 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task97(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1454,7 +1454,7 @@ class Task98 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task98(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1483,7 +1483,7 @@ class Task99 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task99(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -60,7 +60,7 @@ class Task450 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task450(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -89,7 +89,7 @@ class Task451 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task451(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -118,7 +118,7 @@ class Task452 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task452(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -147,7 +147,7 @@ class Task453 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task453(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -176,7 +176,7 @@ class Task454 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task454(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -205,7 +205,7 @@ class Task455 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task455(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -234,7 +234,7 @@ class Task456 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task456(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -263,7 +263,7 @@ class Task457 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task457(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -292,7 +292,7 @@ class Task458 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task458(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -321,7 +321,7 @@ class Task459 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task459(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -350,7 +350,7 @@ class Task460 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task460(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -379,7 +379,7 @@ class Task461 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task461(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -408,7 +408,7 @@ class Task462 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task462(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -437,7 +437,7 @@ class Task463 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task463(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -466,7 +466,7 @@ class Task464 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task464(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -495,7 +495,7 @@ class Task465 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task465(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -524,7 +524,7 @@ class Task466 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task466(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -553,7 +553,7 @@ class Task467 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task467(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -582,7 +582,7 @@ class Task468 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task468(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -611,7 +611,7 @@ class Task469 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task469(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -640,7 +640,7 @@ class Task470 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task470(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -669,7 +669,7 @@ class Task471 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task471(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -698,7 +698,7 @@ class Task472 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task472(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -727,7 +727,7 @@ class Task473 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task473(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -756,7 +756,7 @@ class Task474 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task474(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -785,7 +785,7 @@ class Task475 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task475(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -814,7 +814,7 @@ class Task476 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task476(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -843,7 +843,7 @@ class Task477 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task477(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -872,7 +872,7 @@ class Task478 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task478(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -901,7 +901,7 @@ class Task479 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task479(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -930,7 +930,7 @@ class Task480 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task480(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -959,7 +959,7 @@ class Task481 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task481(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -988,7 +988,7 @@ class Task482 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task482(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1017,7 +1017,7 @@ class Task483 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task483(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1046,7 +1046,7 @@ class Task484 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task484(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1075,7 +1075,7 @@ class Task485 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task485(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1104,7 +1104,7 @@ class Task486 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task486(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1133,7 +1133,7 @@ class Task487 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task487(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1177,7 +1177,7 @@ class Task489 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task489(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1206,7 +1206,7 @@ class Task490 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task490(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1235,7 +1235,7 @@ class Task491 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task491(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1264,7 +1264,7 @@ class Task492 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task492(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1293,7 +1293,7 @@ class Task493 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task493(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1322,7 +1322,7 @@ class Task494 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task494(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1351,7 +1351,7 @@ class Task495 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task495(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1395,7 +1395,7 @@ class Task497 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task497(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1424,7 +1424,7 @@ class Task498 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task498(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1453,7 +1453,7 @@ class Task499 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task499(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
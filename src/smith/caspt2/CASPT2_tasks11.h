@@ -60,7 +60,7 @@ class Task500 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task500(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -89,7 +89,7 @@ class Task501 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task501(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -118,7 +118,7 @@ class Task502 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task502(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -147,7 +147,7 @@ class Task503 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task503(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -176,7 +176,7 @@ class Task504 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task504(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -205,7 +205,7 @@ class Task505 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task505(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -234,7 +234,7 @@ class Task506 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task506(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -263,7 +263,7 @@ class Task507 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task507(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -292,7 +292,7 @@ class Task508 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task508(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -321,7 +321,7 @@ class Task509 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task509(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -350,7 +350,7 @@ class Task510 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task510(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -379,7 +379,7 @@ class Task511 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task511(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -408,7 +408,7 @@ class Task512 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task512(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -437,7 +437,7 @@ class Task513 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task513(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -466,7 +466,7 @@ class Task514 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task514(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -495,7 +495,7 @@ class Task515 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task515(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -524,7 +524,7 @@ class Task516 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task516(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -553,7 +553,7 @@ class Task517 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task517(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -582,7 +582,7 @@ class Task518 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task518(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -642,7 +642,7 @@ class Task521 : public Task {  // merged with gamma
         out_[3]->allocate();
       if (!out_[4]->allocated())
         out_[4]->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task521(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -671,7 +671,7 @@ class Task522 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task522(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -706,7 +706,7 @@ class Task523 : public Task {  // merged with gamma
         out_[3]->allocate();
       if (!out_[4]->allocated())
         out_[4]->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task523(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -735,7 +735,7 @@ class Task524 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task524(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -764,7 +764,7 @@ class Task525 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task525(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -794,7 +794,7 @@ class Task526 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task526(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range, const double e);
@@ -823,7 +823,7 @@ class Task527 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task527(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -852,7 +852,7 @@ class Task528 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task528(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -887,7 +887,7 @@ class Task529 : public Task {  // merged with gamma
         out_[3]->allocate();
       if (!out_[4]->allocated())
         out_[4]->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task529(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -916,7 +916,7 @@ class Task530 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task530(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -945,7 +945,7 @@ class Task531 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task531(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -980,7 +980,7 @@ class Task532 : public Task {  // merged with gamma
         out_[3]->allocate();
       if (!out_[4]->allocated())
         out_[4]->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task532(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1009,7 +1009,7 @@ class Task533 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task533(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1038,7 +1038,7 @@ class Task534 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task534(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1067,7 +1067,7 @@ class Task535 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task535(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1096,7 +1096,7 @@ class Task536 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task536(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1131,7 +1131,7 @@ class Task537 : public Task {  // merged with gamma
         out_[3]->allocate();
       if (!out_[4]->allocated())
         out_[4]->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task537(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1160,7 +1160,7 @@ class Task538 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task538(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1189,7 +1189,7 @@ class Task539 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task539(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1224,7 +1224,7 @@ class Task540 : public Task {  // merged with gamma
         out_[3]->allocate();
       if (!out_[4]->allocated())
         out_[4]->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task540(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1253,7 +1253,7 @@ class Task541 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task541(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1288,7 +1288,7 @@ class Task542 : public Task {  // merged with gamma
         out_[3]->allocate();
       if (!out_[4]->allocated())
         out_[4]->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task542(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1317,7 +1317,7 @@ class Task543 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task543(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1346,7 +1346,7 @@ class Task544 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task544(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1375,7 +1375,7 @@ class Task545 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task545(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1405,7 +1405,7 @@ class Task546 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task546(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range, const double e);
@@ -1434,7 +1434,7 @@ class Task547 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task547(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1463,7 +1463,7 @@ class Task548 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task548(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1492,7 +1492,7 @@ class Task549 : public Task {
         out_->allocate();
       for (auto& i : in_)
         i->init();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task549(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -58,7 +58,7 @@ class Task50 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task50(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -85,7 +85,7 @@ class Task51 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task51(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -112,7 +112,7 @@ class Task52 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task52(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -139,7 +139,7 @@ class Task53 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task53(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -166,7 +166,7 @@ class Task54 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task54(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -193,7 +193,7 @@ class Task55 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task55(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -220,7 +220,7 @@ class Task56 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task56(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -247,7 +247,7 @@ class Task57 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task57(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -274,7 +274,7 @@ class Task58 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task58(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -301,7 +301,7 @@ class Task59 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task59(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -328,7 +328,7 @@ class Task60 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task60(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -355,7 +355,7 @@ class Task61 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task61(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -382,7 +382,7 @@ class Task62 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task62(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -409,7 +409,7 @@ class Task63 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task63(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -436,7 +436,7 @@ class Task64 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task64(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -463,7 +463,7 @@ class Task65 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task65(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -490,7 +490,7 @@ class Task66 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task66(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -517,7 +517,7 @@ class Task67 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task67(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -544,7 +544,7 @@ class Task68 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task68(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -571,7 +571,7 @@ class Task69 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task69(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -598,7 +598,7 @@ class Task70 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task70(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -625,7 +625,7 @@ class Task71 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task71(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -652,7 +652,7 @@ class Task72 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task72(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -679,7 +679,7 @@ class Task73 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task73(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -706,7 +706,7 @@ class Task74 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task74(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -733,7 +733,7 @@ class Task75 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task75(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -760,7 +760,7 @@ class Task76 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task76(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -787,7 +787,7 @@ class Task77 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task77(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -814,7 +814,7 @@ class Task78 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task78(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -841,7 +841,7 @@ class Task79 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task79(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -868,7 +868,7 @@ class Task80 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task80(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -895,7 +895,7 @@ class Task81 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task81(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -922,7 +922,7 @@ class Task82 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task82(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -949,7 +949,7 @@ class Task83 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task83(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -976,7 +976,7 @@ class Task84 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task84(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1003,7 +1003,7 @@ class Task85 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task85(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1030,7 +1030,7 @@ class Task86 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task86(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1057,7 +1057,7 @@ class Task87 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task87(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1084,7 +1084,7 @@ class Task88 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task88(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1111,7 +1111,7 @@ class Task89 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task89(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1138,7 +1138,7 @@ class Task90 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task90(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1165,7 +1165,7 @@ class Task91 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task91(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1192,7 +1192,7 @@ class Task92 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task92(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1219,7 +1219,7 @@ class Task93 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task93(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1246,7 +1246,7 @@ class Task94 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task94(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1273,7 +1273,7 @@ class Task95 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task95(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1300,7 +1300,7 @@ class Task96 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task96(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1327,7 +1327,7 @@ class Task97 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task97(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1354,7 +1354,7 @@ class Task98 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task98(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -1381,7 +1381,7 @@ class Task99 : public Task {  // associated with gamma
     void compute_() override {
       if (!out_->allocated())
         out_->allocate();
-      for (auto& i : subtasks_) i->compute();
+      compute_subtasks(subtasks_);
     }
   public:
     Task99(std::vector<std::shared_ptr<Tensor>> t, std::array<std::shared_ptr<const IndexRange>,3> range);
@@ -27,29 +27,82 @@
 
 #include <src/smith/queue.h>
 #include <src/util/parallel/mpi_interface.h>
+#include <src/util/parallel/profiler.h>
 
 using namespace std;
 using namespace bagel;
 using namespace bagel::SMITH;
 
 shared_ptr<Task> Queue::next_compute() {
-  auto i = tasklist_.begin();
-  for ( ; i != tasklist_.end(); ++i)
-    if ((*i)->ready()) break;
+  if (computed_.empty())
+    compute_wave();
 
-  assert(i != tasklist_.end());
-  shared_ptr<Task> out = *i;
-  // execute
-  out->compute();
+  assert(!computed_.empty());
+  shared_ptr<Task> out = computed_.front();
+  computed_.pop_front();
+  return out;
+}
+
+
+void Queue::schedule() {
+  size_t position = 0;
+  for (auto i = tasklist_.begin(); i != tasklist_.end(); ++i, ++position)
+    pending_.emplace(i->get(), Pending{i, position, 0});
+
+  // only the tasks in this queue are counted as dependencies; the ones in other queues have to be done already
+  for (auto& i : pending_) {
+    for (auto& j : i.first->depend()) {
+      if (j->done())
+        continue;
+      if (!pending_.count(j.get()))
+        throw logic_error("SMITH::Queue: a task depends on an unfinished task in another queue; compute that queue first");
+      ++i.second.ndep;
+    }
+  }
+  for (auto& i : tasklist_)
+    if (pending_.at(i.get()).ndep == 0 && !i->done())
+      ready_.push_back(i);
+  scheduled_ = true;
+}
+
+
+void Queue::compute_wave() {
+  if (!scheduled_)
+    schedule();
+
+  if (ready_.empty())
+    throw logic_error("SMITH::Queue: no task is ready (cyclic dependencies?)");
+  list<shared_ptr<Task>> wave;
+  wave.swap(ready_);
+  // tasks are computed in the order of the task list
+  wave.sort([this](shared_ptr<Task> a, shared_ptr<Task> b) { return pending_.at(a.get()).position < pending_.at(b.get()).position; });
+
+  // execute. Tasks issue collective operations in compute_(), hence they are called in the same order on all the nodes;
+  // the subtasks of each task are run concurrently (see Task::compute_subtasks)
+  Profile prof("SMITH tasks");
+  for (auto& i : wave)
+    i->compute();
 
   // synchronize. This only works because add_block is local...
   mpi__->barrier();
 
-  // delete dependency (to remove intermediate storages)
-  for (auto& j : tasklist_) j->delete_dep(out);
-  // delete this task from the queue
-  tasklist_.erase(i);
-  return out;
+  for (auto& i : wave) {
+    for (auto& j : i->targets()) {
+      shared_ptr<Task> target = j.lock();
+      if (!target) continue;
+      // delete dependency (to remove intermediate storages)
+      target->delete_dep(i);
+      auto iter = pending_.find(target.get());
+      if (iter != pending_.end() && --iter->second.ndep == 0)
+        ready_.push_back(target);
+    }
+    // delete this task from the queue
+    auto iter = pending_.find(i.get());
+    assert(iter != pending_.end());
+    tasklist_.erase(iter->second.iter);
+    pending_.erase(iter);
+  }
+  computed_ = move(wave);
 }
 
 #endif
@@ -37,28 +37,50 @@
 #include <list>
 #include <memory>
 #include <algorithm>
+#include <unordered_map>
 
 namespace bagel {
 namespace SMITH {
 
+// Tasks are computed in waves: all the tasks whose dependencies are satisfied are independent of each other
+// and computed without synchronization, followed by a single barrier. The order of tasks is identical on all the
+// processes, since tasks may contain collective operations (e.g., allocation of tensors).
 class Queue {
   protected:
     std::list<std::shared_ptr<Task>> tasklist_;
 
+    struct Pending {
+      std::list<std::shared_ptr<Task>>::iterator iter;
+      size_t position;  // position in the original task list
+      int ndep;         // number of dependencies that are not yet done
+    };
+    // remaining tasks
+    std::unordered_map<const Task*, Pending> pending_;
+    // tasks that can be computed in the next wave
+    std::list<std::shared_ptr<Task>> ready_;
+    // tasks that have been computed, but not returned by next_compute
+    std::list<std::shared_ptr<Task>> computed_;
+    bool scheduled_ = false;
+
+    void schedule();
+    void compute_wave();
+
   public:
     Queue() {}
     Queue(const std::list<std::shared_ptr<Task>>& d) : tasklist_(d) { }
 
+    // returns a computed task. A wave of tasks is computed when there is none left from the previous wave
     std::shared_ptr<Task> next_compute();
 
-    void add_task(std::shared_ptr<Task> a) { tasklist_.push_back(a); }
+    void add_task(std::shared_ptr<Task> a) { assert(!scheduled_); tasklist_.push_back(a); }
 
     void insert(std::shared_ptr<Queue> b) {
+      assert(!scheduled_);
       for (auto& i : b->tasklist_)
         tasklist_.push_back(i);
     }
 
-    bool done() const { return tasklist_.empty(); }
+    bool done() const { return tasklist_.empty() && computed_.empty(); }
 
     void initialize() {
       for (auto& i : tasklist_) i->initialize();
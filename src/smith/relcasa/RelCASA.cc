@@ -255,11 +255,7 @@ vector<shared_ptr<MultiTensor_<complex<double>>>> RelCASA::RelCASA::solve_linear
 
 #ifndef DISABLE_SERIALIZATION
       if (info_->restart() && (conv || (info_->restart_each_iter() && iter > 0))) {
-        string arch = "RelCASA_";
-        if (mpi__->rank() == 0)
-          arch += "t2_" + to_string(i) + (conv ? "_converged" : "_iter_" + to_string(iter));
-        else
-          arch += "temp_trash";
+        const string arch = "RelCASA_t2_" + to_string(i) + (conv ? "_converged" : "_iter_" + to_string(iter));
         {
           OArchive archive(arch);
           archive << t2all_[i];
@@ -267,7 +263,6 @@ vector<shared_ptr<MultiTensor_<complex<double>>>> RelCASA::RelCASA::solve_linear
         mpi__->barrier();
         if (conv)
           mtimer.tick_print("Save T-amplitude Archive (RelSMITH)");
-        remove("RelCASA_temp_trash.archive");
       }
 #endif
 
@@ -285,11 +285,7 @@ vector<shared_ptr<MultiTensor_<complex<double>>>> RelCASPT2::RelCASPT2::solve_li
 
 #ifndef DISABLE_SERIALIZATION
       if (info_->restart() && (conv || (info_->restart_each_iter() && iter > 0))) {
-        string arch = "RelCASPT2_";
-        if (mpi__->rank() == 0)
-          arch += "t2_" + to_string(i) + (conv ? "_converged" : "_iter_" + to_string(iter));
-        else
-          arch += "temp_trash";
+        const string arch = "RelCASPT2_t2_" + to_string(i) + (conv ? "_converged" : "_iter_" + to_string(iter));
         {
           OArchive archive(arch);
           archive << t2all_[i];
@@ -297,7 +293,6 @@ vector<shared_ptr<MultiTensor_<complex<double>>>> RelCASPT2::RelCASPT2::solve_li
         mpi__->barrier();
         if (conv)
           mtimer.tick_print("Save T-amplitude Archive (RelSMITH)");
-        remove("RelCASPT2_temp_trash.archive");
       }
 #endif
 
@@ -43,6 +43,7 @@ Smith::Smith(const shared_ptr<const PTree> idata, shared_ptr<const Geometry> g,
   const string method = to_lower(idata_->get<string>("method", "caspt2"));
 
 #ifdef COMPILE_SMITH
+  geom_->require_dense_df("SMITH");
   // print a header
   if (!idata->get<bool>("_grad", false))
     cout << "  === SMITH program ===" << endl << endl;
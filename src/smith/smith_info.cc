@@ -26,6 +26,7 @@
 #ifdef COMPILE_SMITH
 
 #include <src/smith/smith_info.h>
+#include <src/smith/storagedisk.h>
 #include <src/wfn/zcoeff.h>
 #include <src/ci/fci/fci.h>
 #include <src/ci/zfci/zharrison.h>
@@ -62,6 +63,15 @@ SMITH_Info<DataType>::SMITH_Info(shared_ptr<const Reference> o, const shared_ptr
   shift_diag_  = idata->get<bool>("shift_diag", true);
   block_diag_fock_ = idata->get<bool>("block_diag_fock", false);
 
+  // tensors can be stored in node-local files, in which case at most "cache_size" MB of them is kept in memory per process
+  const string storage = to_lower(idata->get<string>("storage", "incore"));
+  if (storage != "incore" && storage != "disk")
+    throw runtime_error("storage should be either incore or disk");
+  const size_t cache_size = idata->get<size_t>("cache_size", 4000);
+  SMITH::blockcache__->set(storage == "disk", idata->get<string>("scratch", "."), cache_size*1000000lu);
+  if (storage == "disk")
+    ss << "    * tensors are stored on disk (cache size " << cache_size << " MB per process)" << endl;
+
   // check nact() because ciwfn() is nullptr with zero active orbitals
   if (nact() && ciwfn()->nstates() > 1)
     ss << "    * " << (sssr_ ? "SS-SR" : "MS-MR") << " internal contraction is used" << endl;
@@ -46,14 +46,19 @@ SpinFreeMethod<DataType>::SpinFreeMethod(shared_ptr<const SMITH_Info<DataType>>
 
   const int ncore2 = info_->ncore()*(is_same<DataType,double>::value ? 1 : 2);
 
-  closed_ = IndexRange(info_->nclosed()-info_->ncore(), max, 0, info_->ncore());
+  const int nclosed = info_->nclosed()-info_->ncore();
+  const int nact_offset = ncore2 + nclosed*(is_same<DataType,double>::value ? 1 : 2);
+
+  // block keys are assigned to the active orbitals first, since the higher-order RDMs only carry active indices
+  // and have the fewest bits per index in generate_hash_key
+  active_ = IndexRange(info_->nact(), min(10,max), 0, nact_offset);
   if (is_same<DataType,complex<double>>::value)
-    closed_.merge(IndexRange(info_->nclosed()-info_->ncore(), max, closed_.nblock(), ncore2+closed_.size(), info_->ncore()));
+    active_.merge(IndexRange(info_->nact(), min(10,max), active_.nblock(), nact_offset+active_.size(), nact_offset));
 
-  active_ = IndexRange(info_->nact(), min(10,max), closed_.nblock(), ncore2+closed_.size());
+  closed_ = IndexRange(nclosed, max, active_.nblock(), info_->ncore());
   if (is_same<DataType,complex<double>>::value)
-    active_.merge(IndexRange(info_->nact(), min(10,max), closed_.nblock()+active_.nblock(), ncore2+closed_.size()+active_.size(),
-                                                                                            ncore2+closed_.size()));
+    closed_.merge(IndexRange(nclosed, max, active_.nblock()+closed_.nblock(), ncore2+closed_.size(), info_->ncore()));
+  assert(ncore2+closed_.size() == nact_offset);
 
   virt_ = IndexRange(info_->nvirt(), max, closed_.nblock()+active_.nblock(), ncore2+closed_.size()+active_.size());
   if (is_same<DataType,complex<double>>::value)
@@ -31,31 +31,48 @@
 #define __SRC_SMITH_STORAGE_H
 
 #include <map>
-#include <unordered_map>
+#include <array>
 #include <list>
+#include <limits>
+#include <stdexcept>
 #include <cassert>
 #include <algorithm>
 #include <numeric>
 #include <src/smith/indexrange.h>
+#include <src/smith/blocktable.h>
 #include <src/util/parallel/mpi_interface.h>
 #include <src/util/parallel/rmawindow.h>
+#include <src/util/io/chunkfile.h>
 
 namespace bagel {
 namespace SMITH {
 
 
-// this assumes < 256 blocks; TODO runtime determination?
-const static int shift = 8;
+// Block keys are packed into a size_t with a stride that depends on the rank of the tensor:
+// 16 bits per index for four-index tensors, 8 bits for eight-index tensors, and so on.
+static constexpr int key_bits(const size_t rank) {
+  return rank > 1 ? std::numeric_limits<size_t>::digits / rank : std::numeric_limits<size_t>::digits;
+}
+
+static size_t append_hash_key(const size_t out, const size_t key, const int bits) {
+  if (bits == std::numeric_limits<size_t>::digits)
+    return key;
+  if (key >> bits)
+    throw std::logic_error("too many blocks for the hash key in SMITH; increase maxtile");
+  return (out << bits) + key;
+}
 
 static size_t generate_hash_key(const std::vector<size_t>& o) {
+  const int bits = key_bits(o.size());
   size_t out = 0;
-  for (auto i = o.rbegin(); i != o.rend(); ++i) { out <<= shift; out += *i; }
+  for (auto i = o.rbegin(); i != o.rend(); ++i) out = append_hash_key(out, *i, bits);
   return out;
 }
 
 static size_t generate_hash_key(const std::vector<Index>& o) {
+  const int bits = key_bits(o.size());
   size_t out = 0;
-  for (auto i = o.rbegin(); i != o.rend(); ++i) { out <<= shift; out += i->key(); }
+  for (auto i = o.rbegin(); i != o.rend(); ++i) out = append_hash_key(out, i->key(), bits);
   return out;
 }
 
@@ -63,7 +80,11 @@ static size_t generate_hash_key() { return 0; }
 
 template<class T, typename... args>
 size_t generate_hash_key(const T& head, const args&... tail) {
-  return (generate_hash_key(tail...) << shift) + head.key();
+  const std::array<size_t, sizeof...(args)+1> keys{{head.key(), tail.key()...}};
+  const int bits = key_bits(keys.size());
+  size_t out = 0;
+  for (auto i = keys.rbegin(); i != keys.rend(); ++i) out = append_hash_key(out, *i, bits);
+  return out;
 }
 
 
@@ -96,7 +117,7 @@ class StorageIncore : public RMAWindow<DataType> {
     size_t totalsize_;
 
     // this relates hash keys to lo and high of the block
-    std::unordered_map<size_t, std::pair<size_t, size_t>> hashtable_;
+    BlockTable<std::pair<size_t, size_t>> hashtable_;
     // distribution information. Relates lo and the process number
     std::map<size_t, int> blocks_;
 
@@ -119,9 +140,25 @@ class StorageIncore : public RMAWindow<DataType> {
         hashtable_ordered.emplace(i);
       ar << RMAWindow<DataType>::initialized_ << totalsize_ << hashtable_ordered;
 
-      // Process 0 collects and saves tensor's contents, tile by tile
-      // Other processes do nothing; this requires them to be writing to a different file from Process 0
-      if (mpi__->rank() == 0) {
+      // When written through OArchive, each process saves its own tiles to its chunk file
+      ChunkWriter* chunks = ChunkWriter::current();
+      const bool chunked = chunks && RMAWindow<DataType>::initialized_;
+      ar << chunked;
+      if (chunked) {
+        const uint64_t object = chunks->new_object();
+        const int nproc = mpi__->size();
+        ar << object << nproc;
+        const DataType* local = this->local_data();
+        for (auto& i : hashtable_ordered) {
+          size_t rank, off, size;
+          std::tie(rank, off, size) = locate(i.first);
+          if (rank == mpi__->rank() && size > 0) {
+            this->touch(off, size);
+            chunks->write(object, i.first, local + off, size*sizeof(DataType));
+          }
+        }
+      // Otherwise process 0 collects and saves tensor's contents, tile by tile
+      } else if (mpi__->rank() == 0) {
         for (auto& i : hashtable_ordered) {
           size_t rank, off, size;
           std::tie(rank, off, size) = locate(i.first);
@@ -165,14 +202,32 @@ class StorageIncore : public RMAWindow<DataType> {
       if (init)
         initialize();
 
-      // All processes read the whole archive, and save the data that belong to them
-      for (auto& i : hashtable_ordered) {
-        size_t rank, off, size;
-        std::tie(rank, off, size) = locate(i.first);
-        std::vector<DataType> tmp(size, 0.0);
-        ar >> tmp;
-        if (rank == mpi__->rank())
-          rma_put(tmp.data(), i.first);
+      bool chunked;
+      ar >> chunked;
+      if (chunked) {
+        uint64_t object;
+        int nproc;
+        ar >> object >> nproc;
+        ChunkReader* chunks = ChunkReader::current();
+        if (!chunks)
+          throw std::runtime_error("Tensors with chunked data can only be read through IArchive");
+        // Only the tiles that belong to this process are paged in from the (mapped) chunk files
+        for (auto& i : hashtable_ordered) {
+          size_t rank, off, size;
+          std::tie(rank, off, size) = locate(i.first);
+          if (rank == mpi__->rank() && size > 0)
+            rma_put(reinterpret_cast<const DataType*>(chunks->find(nproc, object, i.first, size*sizeof(DataType))), i.first);
+        }
+      } else {
+        // All processes read the whole archive, and save the data that belong to them
+        for (auto& i : hashtable_ordered) {
+          size_t rank, off, size;
+          std::tie(rank, off, size) = locate(i.first);
+          std::vector<DataType> tmp(size, 0.0);
+          ar >> tmp;
+          if (rank == mpi__->rank())
+            rma_put(tmp.data(), i.first);
+        }
       }
       mpi__->barrier();
     }
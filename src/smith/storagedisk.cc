@@ -0,0 +1,238 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: storagedisk.cc
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <bagel_config.h>
+#ifdef COMPILE_SMITH
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sstream>
+#include <algorithm>
+#include <src/smith/storagedisk.h>
+
+using namespace std;
+using namespace bagel;
+using namespace bagel::SMITH;
+
+namespace bagel {
+namespace SMITH {
+  static BlockCache blockcache;
+  BlockCache* blockcache__ = &blockcache;
+}
+}
+
+namespace {
+  const size_t pagesize = sysconf(_SC_PAGESIZE);
+  // page-aligned region that covers [ptr, ptr+size)
+  pair<char*, size_t> page_range(char* ptr, const size_t size) {
+    char* lo = reinterpret_cast<char*>(reinterpret_cast<size_t>(ptr) / pagesize * pagesize);
+    char* hi = reinterpret_cast<char*>((reinterpret_cast<size_t>(ptr + size) + pagesize - 1) / pagesize * pagesize);
+    return make_pair(lo, hi - lo);
+  }
+  // writes back and releases the pages that lie entirely in [ptr, ptr+size), so that the neighbors are not affected
+  void release_pages(char* ptr, const size_t size) {
+    char* lo = reinterpret_cast<char*>((reinterpret_cast<size_t>(ptr) + pagesize - 1) / pagesize * pagesize);
+    char* hi = reinterpret_cast<char*>(reinterpret_cast<size_t>(ptr + size) / pagesize * pagesize);
+    if (lo < hi) {
+      msync(lo, hi - lo, MS_ASYNC);
+      madvise(lo, hi - lo, MADV_DONTNEED);
+    }
+  }
+}
+
+
+void BlockCache::set(const bool disk, const string& directory, const size_t budget) {
+  lock_guard<mutex> lock(mutex_);
+  disk_ = disk;
+  directory_ = directory;
+  budget_ = budget;
+}
+
+
+string BlockCache::filename() {
+  lock_guard<mutex> lock(mutex_);
+  stringstream ss; ss << directory_ << "/smith_" << getpid() << "_" << mpi__->rank() << "_" << nfile_++ << ".tmp";
+  return ss.str();
+}
+
+
+void BlockCache::evict(const Block& b) {
+  // the mapping is shared, so that the data are written back to the file and read in again when needed
+  release_pages(b.ptr, b.size);
+  resident_ -= b.size;
+}
+
+
+void BlockCache::touch(char* ptr, const size_t size, char* next, const size_t nsize) {
+  lock_guard<mutex> lock(mutex_);
+  auto iter = map_.find(ptr);
+  if (iter != map_.end()) {
+    lru_.splice(lru_.begin(), lru_, iter->second);
+    return;
+  }
+  lru_.push_front(Block{ptr, size});
+  map_.emplace(ptr, lru_.begin());
+  resident_ += size;
+
+  // read-ahead of the next local block
+  if (next && !map_.count(next)) {
+    pair<char*, size_t> range = page_range(next, nsize);
+    madvise(range.first, range.second, MADV_WILLNEED);
+  }
+
+  while (resident_ > budget_ && lru_.size() > 1) {
+    evict(lru_.back());
+    map_.erase(lru_.back().ptr);
+    lru_.pop_back();
+  }
+}
+
+
+void BlockCache::remove(const char* begin, const char* end) {
+  lock_guard<mutex> lock(mutex_);
+  for (auto i = lru_.begin(); i != lru_.end(); ) {
+    if (i->ptr >= begin && i->ptr < end) {
+      resident_ -= i->size;
+      map_.erase(i->ptr);
+      i = lru_.erase(i);
+    } else {
+      ++i;
+    }
+  }
+}
+
+
+void BlockCache::trim(char* begin, char* end) {
+  lock_guard<mutex> lock(mutex_);
+  vector<pair<char*, size_t>> held;
+  for (auto& i : lru_)
+    if (i.ptr >= begin && i.ptr < end)
+      held.emplace_back(i.ptr, i.size);
+  sort(held.begin(), held.end());
+  char* current = begin;
+  for (auto& i : held) {
+    if (i.first > current)
+      release_pages(current, i.first - current);
+    current = max(current, i.first + i.second);
+  }
+  if (end > current)
+    release_pages(current, end - current);
+}
+
+
+template<typename DataType>
+StorageDisk<DataType>::StorageDisk(const map<size_t, size_t>& size, const bool init) : StorageIncore<DataType>(size, false), fd_(-1), mapsize_(0lu) {
+  // StorageIncore cannot call the virtual function create_window in its constructor
+  if (init)
+    this->initialize();
+}
+
+
+template<typename DataType>
+void StorageDisk<DataType>::create_window() {
+  const size_t localsize = this->localsize();
+  mapsize_ = max(localsize*sizeof(DataType), sizeof(DataType));
+
+  filename_ = blockcache__->filename();
+  fd_ = open(filename_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd_ < 0)
+    throw runtime_error("StorageDisk could not open " + filename_);
+  // the file is removed from the directory right away, and deleted when it is closed
+  unlink(filename_.c_str());
+  if (ftruncate(fd_, mapsize_) != 0)
+    throw runtime_error("StorageDisk could not allocate " + filename_);
+
+  void* ptr = mmap(nullptr, mapsize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (ptr == MAP_FAILED)
+    throw runtime_error("StorageDisk could not map " + filename_);
+  win_base_ = static_cast<DataType*>(ptr);
+
+  local_blocks_.clear();
+  for (auto& i : hashtable_)
+    if (i.second.first >= local_lo_ && i.second.first < local_hi_)
+      local_blocks_.emplace(i.second.first - local_lo_, i.second.second - i.second.first);
+
+#ifdef HAVE_MPI_H
+  MPI_Win_create(win_base_, localsize*sizeof(DataType), sizeof(DataType), MPI_INFO_NULL, mpi__->mpi_comm(), &win_);
+#endif
+}
+
+
+template<typename DataType>
+StorageDisk<DataType>::~StorageDisk() {
+  // the window has to be freed before the memory is unmapped
+  if (this->initialized())
+    this->free_window();
+  if (mapsize_) {
+    char* base = reinterpret_cast<char*>(win_base_);
+    blockcache__->remove(base, base + mapsize_);
+    munmap(win_base_, mapsize_);
+  }
+  if (fd_ >= 0)
+    close(fd_);
+}
+
+
+// every block that overlaps with [off, off+size) is registered; the block after each of them is read ahead
+template<typename DataType>
+void StorageDisk<DataType>::touch(const size_t off, const size_t size) const {
+  auto iter = local_blocks_.upper_bound(off);
+  if (iter != local_blocks_.begin() && prev(iter)->first + prev(iter)->second > off)
+    --iter;
+  for ( ; iter != local_blocks_.end() && iter->first < off + size; ++iter) {
+    auto next = std::next(iter);
+    char* ptr = reinterpret_cast<char*>(win_base_ + iter->first);
+    if (next != local_blocks_.end())
+      blockcache__->touch(ptr, iter->second*sizeof(DataType), reinterpret_cast<char*>(win_base_ + next->first), next->second*sizeof(DataType));
+    else
+      blockcache__->touch(ptr, iter->second*sizeof(DataType));
+  }
+}
+
+
+// a quarter of the budget, so that the chunks of two windows fit in memory at the same time
+template<typename DataType>
+size_t StorageDisk<DataType>::chunk_size() const {
+  return max(blockcache__->budget() / (4*sizeof(DataType)), static_cast<size_t>(1));
+}
+
+
+template<typename DataType>
+void StorageDisk<DataType>::after_fence() const {
+  if (mapsize_) {
+    char* base = reinterpret_cast<char*>(win_base_);
+    blockcache__->trim(base, base + mapsize_);
+  }
+}
+
+
+// explicit instantiation
+template class StorageDisk<double>;
+template class StorageDisk<complex<double>>;
+
+BOOST_CLASS_EXPORT_IMPLEMENT(StorageDisk<double>)
+BOOST_CLASS_EXPORT_IMPLEMENT(StorageDisk<complex<double>>)
+
+#endif
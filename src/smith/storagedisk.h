@@ -0,0 +1,130 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: storagedisk.h
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// Disk-based storage for SMITH tensors. The local part of the distributed array is a memory-mapped file
+// in a node-local directory that is attached to an RMA window, so that all the RMA operations work as in StorageIncore.
+// Local blocks are tracked by a process-wide LRU cache; when the resident size exceeds the memory budget,
+// the least recently used blocks are written back and released from memory. Whole-window operations go through
+// the cache chunk by chunk; pages brought in by the RMA operations of other processes are released at every fence.
+
+#ifndef __SRC_SMITH_STORAGEDISK_H
+#define __SRC_SMITH_STORAGEDISK_H
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <src/smith/storage.h>
+
+namespace bagel {
+namespace SMITH {
+
+class BlockCache {
+  protected:
+    struct Block {
+      char* ptr;
+      size_t size;
+    };
+    std::list<Block> lru_;
+    std::unordered_map<const char*, std::list<Block>::iterator> map_;
+
+    bool disk_;
+    std::string directory_;
+    size_t budget_;
+    size_t resident_;
+    size_t nfile_;
+
+    std::mutex mutex_;
+
+    void evict(const Block& b);
+
+  public:
+    BlockCache() : disk_(false), directory_("."), budget_(0lu), resident_(0lu), nfile_(0lu) { }
+
+    // set from the smith input block
+    void set(const bool disk, const std::string& directory, const size_t budget);
+
+    bool disk() const { return disk_; }
+    std::string filename();
+
+    // registers an access to a block and evicts the least recently used blocks if necessary
+    void touch(char* ptr, const size_t size, char* next = nullptr, const size_t nsize = 0lu);
+    // removes all the blocks in [begin, end) when a file is unmapped
+    void remove(const char* begin, const char* end);
+    // releases the pages in [begin, end) that are not held by the cache (i.e., paged in by RMA operations of other processes)
+    void trim(char* begin, char* end);
+
+    size_t budget() const { return budget_; }
+    size_t resident() const { return resident_; }
+};
+
+extern BlockCache* blockcache__;
+
+
+template<typename DataType>
+class StorageDisk : public StorageIncore<DataType> {
+  protected:
+    using RMAWindow<DataType>::win_;
+    using RMAWindow<DataType>::win_base_;
+    using StorageIncore<DataType>::hashtable_;
+    using StorageIncore<DataType>::local_lo_;
+    using StorageIncore<DataType>::local_hi_;
+
+    std::string filename_;
+    int fd_;
+    size_t mapsize_;
+
+    // local offsets of the blocks in this process (sorted), used for read-ahead
+    std::map<size_t, size_t> local_blocks_;
+
+    void create_window() override;
+    void touch(const size_t off, const size_t size) const override;
+    size_t chunk_size() const override;
+    void after_fence() const override;
+
+  private:
+    // serialization
+    friend class boost::serialization::access;
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned int) {
+      ar & boost::serialization::base_object<StorageIncore<DataType>>(*this);
+    }
+
+  public:
+    StorageDisk() : fd_(-1), mapsize_(0lu) { }
+    StorageDisk(const std::map<size_t, size_t>& size, const bool init);
+    ~StorageDisk();
+};
+
+extern template class StorageDisk<double>;
+extern template class StorageDisk<std::complex<double>>;
+
+}
+}
+
+#include <src/util/archive.h>
+BOOST_CLASS_EXPORT_KEY(bagel::SMITH::StorageDisk<double>)
+BOOST_CLASS_EXPORT_KEY(bagel::SMITH::StorageDisk<std::complex<double>>)
+
+#endif
@@ -30,6 +30,7 @@
 #include <list>
 #include <memory>
 #include <algorithm>
+#include <src/util/taskqueue.h>
 #include <src/smith/storage.h>
 
 namespace bagel {
@@ -44,6 +45,16 @@ class Task : public std::enable_shared_from_this<Task> {
     bool done_;
     virtual void compute_() = 0;
 
+    // subtasks only read their input blocks and accumulate into local blocks of the output, so they run concurrently.
+    // All the collective operations of a task (allocation, initialization) are done before its subtasks.
+    template<typename T>
+    static void compute_subtasks(const std::vector<std::shared_ptr<T>>& subtasks) {
+      TaskQueue<std::shared_ptr<T>> tasks(subtasks.size());
+      for (auto& i : subtasks)
+        tasks.emplace_back(i);
+      tasks.compute();
+    }
+
   public:
     Task() : done_(false) {}
     Task(std::list<std::shared_ptr<Task>>& d) : depend_(d), done_(false) {}
@@ -64,6 +75,8 @@ class Task : public std::enable_shared_from_this<Task> {
     }
 
     void set_target(std::shared_ptr<Task> b) { target_.push_back(b); }
+    const std::list<std::weak_ptr<Task>>& targets() const { return target_; }
+    const std::list<std::shared_ptr<Task>>& depend() const { return depend_; }
 
     void initialize() { done_ = false; }
 
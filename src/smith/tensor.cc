@@ -27,6 +27,7 @@
 
 #include <src/smith/tensor.h>
 #include <src/smith/storagekramers.h>
+#include <src/smith/storagedisk.h>
 
 using namespace std;
 using namespace bagel;
@@ -55,7 +56,9 @@ Tensor_<DataType>::Tensor_(vector<IndexRange> in, const bool kramers, const unor
         hashmap.emplace(key, size);
     }
 
-    if (!kramers)
+    if (!kramers && blockcache__->disk())
+      data_ = make_shared<StorageDisk<DataType>>(hashmap, alloc);
+    else if (!kramers)
       data_ = make_shared<Storage<DataType>>(hashmap, alloc);
     else
       data_ = make_shared<StorageKramers<DataType>>(hashmap, alloc);
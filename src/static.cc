@@ -31,6 +31,7 @@
 #include <src/util/string.h>
 #include <src/util/parallel/mpi_interface.h>
 #include <src/util/parallel/resources.h>
+#include <src/util/parallel/profiler.h>
 
 // They are used from other files
 namespace bagel{
@@ -64,6 +65,9 @@ void static_variables() {
     resources__ = resources.get();
   }
 
+  // profiling regions are collected if BAGEL_PROFILE is set
+  Profiler::init();
+
   // rounding mode in std::rint, std::lrint, and std::llrint
   fesetround(FE_TONEAREST);
 }
@@ -85,7 +85,11 @@ BOOST_AUTO_TEST_SUITE(TEST_SCF)
 
 BOOST_AUTO_TEST_CASE(DF_HF) {
     BOOST_CHECK(compare(scf_energy("hf_svp_hf"),          -99.84779026));
+    BOOST_CHECK(compare(scf_energy("hf_svp_hf_reset"),    -99.84779026));
     BOOST_CHECK(compare(scf_energy("hf_svp_dfhf"),        -99.84772354));
+    BOOST_CHECK(compare(scf_energy("hf_svp_dfhf_sparse"), -99.84772354));
+    BOOST_CHECK(compare(scf_energy("hf_svp_dfhf_screen"), -99.84772354));
+    BOOST_CHECK(compare(scf_energy("hf_svp_dfhf_single"), -99.84772354, 1.0e-5));
 #ifndef DISABLE_SERIALIZATION
     BOOST_CHECK(compare(scf_energy("hf_svp_dfhf_restart"),-99.84772354));
 #endif
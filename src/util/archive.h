@@ -31,6 +31,8 @@
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/serialization/export.hpp>
+#include <src/util/io/chunkfile.h>
+#include <src/util/parallel/mpi_interface.h>
 
 namespace bagel {
 
@@ -38,15 +40,26 @@ class OArchive {
   protected:
     std::string filename_;
     std::ofstream os_;
+    NullBuffer nullbuf_;
+    std::ostream null_;
 
     using Ostream = boost::archive::binary_oarchive;
     std::shared_ptr<Ostream> archive_;
 
+    // bulk data (e.g., distributed tensors) are written by each process to its own file
+    ChunkWriter chunks_;
+
   public:
-    OArchive(std::string name) : filename_(name+".archive"), os_(filename_) {
-      if (!os_.is_open())
-        throw std::runtime_error("Error trying to create the file " + filename_ + ".  Possibly the target directory is not accessible.");
-      archive_ = std::make_shared<Ostream>(os_);
+    // collective: process 0 writes the archive, and every process writes its chunks
+    OArchive(std::string name) : filename_(name+".archive"), null_(&nullbuf_), chunks_(filename_, mpi__->rank()) {
+      if (mpi__->rank() == 0) {
+        os_.open(filename_);
+        if (!os_.is_open())
+          throw std::runtime_error("Error trying to create the file " + filename_ + ".  Possibly the target directory is not accessible.");
+        archive_ = std::make_shared<Ostream>(os_);
+      } else {
+        archive_ = std::make_shared<Ostream>(null_);
+      }
     }
 
     template<typename T>
@@ -68,8 +81,10 @@ class IArchive {
     using Istream = boost::archive::binary_iarchive;
     std::shared_ptr<Istream> archive_;
 
+    ChunkReader chunks_;
+
   public:
-    IArchive(std::string name) : filename_(name+".archive"), is_(filename_) {
+    IArchive(std::string name) : filename_(name+".archive"), is_(filename_), chunks_(filename_) {
       if (!is_.is_open())
         throw std::runtime_error("File not found: " + filename_);
       archive_ = std::make_shared<Istream>(is_);
@@ -29,6 +29,7 @@
 #include <cmath>
 #include <chrono>
 #include <stddef.h>
+#include <bagel_config.h>
 
 namespace bagel {
 
@@ -72,7 +73,17 @@ static const double au2wavenumber__ = 1.0 / (2.0 * pi__ * c__ * au2meter__ * 100
 *  Numerical constants                                      *
 ************************************************************/
 static constexpr double numerical_zero__ = 1.0e-15;
+
+// maximum number of orbitals in determinant strings (set with --with-max-orbitals at configure time)
+#ifdef CI_MAX_ORBITALS
+static constexpr unsigned int nbit__ = CI_MAX_ORBITALS;
+#else
 static constexpr unsigned int nbit__ = 64;
+#endif
+static_assert(nbit__ % 64 == 0, "the maximum number of orbitals in determinant strings should be a multiple of 64");
+
+// number of bits in the keys of the octree for periodic FMM
+static constexpr unsigned int nbit_key__ = 64;
 
 }
 
@@ -0,0 +1,58 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: hash.h
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+
+#ifndef __SRC_UTIL_HASH_H
+#define __SRC_UTIL_HASH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bagel {
+
+// FNV-1a, which (unlike std::hash) is the same across compilers and runs; used to identify files written by earlier runs
+class Hash {
+  protected:
+    uint64_t hash_ = 14695981039346656037ull;
+  public:
+    void add(const void* data, const size_t n) {
+      const unsigned char* c = static_cast<const unsigned char*>(data);
+      for (size_t i = 0; i != n; ++i) {
+        hash_ ^= c[i];
+        hash_ *= 1099511628211ull;
+      }
+    }
+    template<typename T>
+    void add(const T& o) { add(&o, sizeof(T)); }
+    void add(const std::string& o) { add(o.size()); add(o.data(), o.size()); }
+    template<typename T>
+    void add(const std::vector<T>& o) { add(o.size()); for (auto& i : o) add(i); }
+    uint64_t hash() const { return hash_; }
+};
+
+}
+
+#endif
@@ -0,0 +1,157 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: chunkfile.cc
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <src/util/io/chunkfile.h>
+
+using namespace std;
+using namespace bagel;
+
+namespace {
+
+struct ChunkTrailer {
+  char magic[8];
+  uint64_t nentry;
+  uint64_t index_offset;
+};
+
+const char chunkmagic__[8] = {'B', 'A', 'G', 'E', 'L', 'C', 'K', '1'};
+
+}
+
+thread_local ChunkWriter* ChunkWriter::current_ = nullptr;
+thread_local ChunkReader* ChunkReader::current_ = nullptr;
+
+
+MappedFile::MappedFile(const string& file) : fd_(::open(file.c_str(), O_RDONLY)), size_(0), ptr_(MAP_FAILED) {
+  struct stat st;
+  if (fd_ >= 0 && fstat(fd_, &st) == 0 && st.st_size > 0) {
+    size_ = st.st_size;
+    ptr_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+  }
+}
+
+
+MappedFile::~MappedFile() {
+  if (ptr_ != MAP_FAILED)
+    munmap(ptr_, size_);
+  if (fd_ >= 0)
+    close(fd_);
+}
+
+
+bool MappedFile::good() const {
+  return ptr_ != MAP_FAILED;
+}
+
+
+ChunkWriter::ChunkWriter(const string& archive, const int rank) : filename_(archive + "." + to_string(rank)), offset_(0lu), nobject_(0lu), previous_(current_) {
+  current_ = this;
+}
+
+
+ChunkWriter::~ChunkWriter() {
+  current_ = previous_;
+  // nothing has been written; no file is created
+  if (!os_.is_open())
+    return;
+
+  ChunkTrailer trailer;
+  copy_n(chunkmagic__, 8, trailer.magic);
+  trailer.nentry = index_.size();
+  trailer.index_offset = offset_;
+  os_.write(reinterpret_cast<const char*>(index_.data()), index_.size()*sizeof(ChunkEntry));
+  os_.write(reinterpret_cast<const char*>(&trailer), sizeof(ChunkTrailer));
+}
+
+
+uint64_t ChunkWriter::new_object() {
+  // every process creates its file, so that a stale file from a previous run is never read
+  if (!os_.is_open()) {
+    os_.open(filename_, ios::binary | ios::trunc);
+    if (!os_.is_open())
+      throw runtime_error("Error trying to create the file " + filename_ + ".  Possibly the target directory is not accessible.");
+  }
+  return nobject_++;
+}
+
+
+void ChunkWriter::write(const uint64_t object, const uint64_t key, const void* data, const size_t size) {
+  assert(os_.is_open() && object < nobject_);
+  os_.write(static_cast<const char*>(data), size);
+  if (!os_.good())
+    throw runtime_error("Error writing to the file " + filename_);
+  index_.push_back({object, key, offset_, size});
+  offset_ += size;
+}
+
+
+ChunkReader::ChunkReader(const string& archive) : archive_(archive), nfile_(0), previous_(current_) {
+  current_ = this;
+}
+
+
+ChunkReader::~ChunkReader() {
+  current_ = previous_;
+}
+
+
+void ChunkReader::open(const int nfile) {
+  // only the indices are read here; the data are paged in by find
+  for (int rank = nfile_; rank < nfile; ++rank) {
+    const string file = archive_ + "." + to_string(rank);
+    auto map = make_shared<const MappedFile>(file);
+    if (!map->good() || map->size() < sizeof(ChunkTrailer))
+      throw runtime_error("File not found: " + file);
+    const ChunkTrailer* trailer = reinterpret_cast<const ChunkTrailer*>(map->data() + map->size() - sizeof(ChunkTrailer));
+    if (!equal(chunkmagic__, chunkmagic__+8, trailer->magic) || trailer->index_offset + trailer->nentry*sizeof(ChunkEntry) + sizeof(ChunkTrailer) != map->size())
+      throw runtime_error("The file " + file + " is not a valid chunk file; possibly it has been truncated.");
+
+    const ChunkEntry* entry = reinterpret_cast<const ChunkEntry*>(map->data() + trailer->index_offset);
+    for (size_t i = 0; i != trailer->nentry; ++i)
+      index_.emplace(make_pair(entry[i].object, entry[i].key), make_pair(rank, entry[i]));
+    files_.push_back(map);
+  }
+  nfile_ = max(nfile_, nfile);
+}
+
+
+const char* ChunkReader::find(const int nfile, const uint64_t object, const uint64_t key, const size_t size) {
+  if (nfile > nfile_)
+    open(nfile);
+  auto iter = index_.find(make_pair(object, key));
+  if (iter == index_.end() || iter->second.first >= nfile)
+    throw runtime_error("A chunk was not found in " + archive_ + ".*");
+  if (iter->second.second.size != size)
+    throw runtime_error("A chunk in " + archive_ + ".* has an unexpected size.");
+  return files_[iter->second.first]->data() + iter->second.second.offset;
+}
@@ -0,0 +1,127 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: chunkfile.h
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __SRC_UTIL_IO_CHUNKFILE_H
+#define __SRC_UTIL_IO_CHUNKFILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <fstream>
+#include <streambuf>
+
+namespace bagel {
+
+// Read-only mapping of a file. Pages are only read from disk when they are accessed.
+class MappedFile {
+  protected:
+    int fd_;
+    size_t size_;
+    void* ptr_;
+
+  public:
+    MappedFile(const std::string& file);
+    MappedFile(const MappedFile&) = delete;
+    ~MappedFile();
+
+    bool good() const;
+    size_t size() const { return size_; }
+    const char* data() const { return static_cast<const char*>(ptr_); }
+};
+
+
+// Stream buffer that discards everything (used by the processes that do not write the main archive)
+class NullBuffer : public std::streambuf {
+  protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+
+// Index entry of a chunk file. Chunks are identified by the serialized object and a key within the object.
+struct ChunkEntry {
+  uint64_t object;
+  uint64_t key;
+  uint64_t offset;
+  uint64_t size;
+};
+
+
+// Each process appends its chunks to "<archive>.<rank>". The index and a fixed-size trailer are written at the end
+// when the writer is destroyed. The writer registers itself so that serialize functions can find it through current().
+class ChunkWriter {
+  protected:
+    std::string filename_;
+    std::ofstream os_;
+    std::vector<ChunkEntry> index_;
+    uint64_t offset_;
+    uint64_t nobject_;
+
+    ChunkWriter* previous_;
+    static thread_local ChunkWriter* current_;
+
+  public:
+    ChunkWriter(const std::string& archive, const int rank);
+    ChunkWriter(const ChunkWriter&) = delete;
+    ~ChunkWriter();
+
+    // returns a new object number and creates the file; should be called in the same order on all the processes
+    uint64_t new_object();
+    void write(const uint64_t object, const uint64_t key, const void* data, const size_t size);
+
+    static ChunkWriter* current() { return current_; }
+};
+
+
+// Counterpart of ChunkWriter. The files of all the writing processes are mapped on demand (the number of processes may
+// have changed since the archive was written), so each process only reads the pages of the chunks that it requests.
+class ChunkReader {
+  protected:
+    std::string archive_;
+    int nfile_;
+    std::vector<std::shared_ptr<const MappedFile>> files_;
+    std::map<std::pair<uint64_t, uint64_t>, std::pair<int, ChunkEntry>> index_;
+
+    ChunkReader* previous_;
+    static thread_local ChunkReader* current_;
+
+    void open(const int nfile);
+
+  public:
+    ChunkReader(const std::string& archive);
+    ChunkReader(const ChunkReader&) = delete;
+    ~ChunkReader();
+
+    // returns a pointer to the chunk written by one of nfile processes. Throws if the chunk is not found or has the wrong size.
+    const char* find(const int nfile, const uint64_t object, const uint64_t key, const size_t size);
+
+    static ChunkReader* current() { return current_; }
+};
+
+}
+
+#endif
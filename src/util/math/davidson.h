@@ -34,6 +34,7 @@
 #include <src/util/math/matrix.h>
 #include <src/util/f77.h>
 #include <src/util/serialization.h>
+#include <src/util/parallel/profiler.h>
 
 namespace bagel {
 
@@ -90,6 +91,7 @@ class DavidsonDiag_ {
     }
 
     std::vector<double> compute(std::vector<std::shared_ptr<const T>> cc, std::vector<std::shared_ptr<const U>> cs) {
+      Profile prof("Davidson");
       // reset the convergence flags
       std::vector<bool> converged(nstate_, false);
 
@@ -23,6 +23,7 @@
 //
 
 #include <src/util/math/matrix_base.h>
+#include <src/util/parallel/profiler.h>
 
 using namespace std;
 using namespace bagel;
@@ -30,6 +31,7 @@ using namespace bagel;
 
 template<typename DataType>
 Matrix_base<DataType>::Matrix_base(const size_t n, const size_t m, const bool local) : btas::Tensor2<DataType>(n, m), localized_(local) {
+  Profiler::allocated(n*m*sizeof(DataType));
 #ifdef HAVE_SCALAPACK
   if (!localized_) {
     desc_ = mpi__->descinit(ndim(), mdim());
@@ -42,6 +44,7 @@ Matrix_base<DataType>::Matrix_base(const size_t n, const size_t m, const bool lo
 
 template<typename DataType>
 Matrix_base<DataType>::Matrix_base(const Matrix_base& o) : btas::Tensor2<DataType>(o.ndim(), o.mdim()), localized_(o.localized_) {
+  Profiler::allocated(o.size()*sizeof(DataType));
 #ifdef HAVE_SCALAPACK
   if (!localized_) {
     desc_ = mpi__->descinit(ndim(), mdim());
@@ -54,6 +57,7 @@ Matrix_base<DataType>::Matrix_base(const Matrix_base& o) : btas::Tensor2<DataTyp
 
 template<typename DataType>
 Matrix_base<DataType>::Matrix_base(const MatView_<DataType>& o) : btas::Tensor2<DataType>(o.ndim(), o.mdim()), localized_(o.localized()) {
+  Profiler::allocated(o.size()*sizeof(DataType));
   copy_n(o.data(), o.size(), data());
 #ifdef HAVE_SCALAPACK
   if (!localized_) {
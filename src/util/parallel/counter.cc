@@ -0,0 +1,63 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: counter.cc
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <src/util/parallel/counter.h>
+#include <src/util/parallel/mpi_interface.h>
+
+using namespace std;
+using namespace bagel;
+
+Counter::Counter() : local_(0) {
+#ifdef HAVE_MPI_H
+  MPI_Win_allocate(mpi__->rank() == 0 ? sizeof(int) : 0, sizeof(int), MPI_INFO_NULL, mpi__->mpi_comm(), &win_base_, &win_);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+  if (mpi__->rank() == 0) {
+    *win_base_ = 0;
+    MPI_Win_sync(win_);
+  }
+  mpi__->barrier();
+#endif
+}
+
+
+Counter::~Counter() {
+#ifdef HAVE_MPI_H
+  MPI_Win_unlock_all(win_);
+  MPI_Win_free(&win_);
+#endif
+}
+
+
+int Counter::next() {
+#ifdef HAVE_MPI_H
+  const int one = 1;
+  int out;
+  MPI_Fetch_and_op(&one, &out, MPI_INT, 0, 0, MPI_SUM, win_);
+  MPI_Win_flush(0, win_);
+  return out;
+#else
+  return local_++;
+#endif
+}
@@ -0,0 +1,58 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: counter.h
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __SRC_PARALLEL_COUNTER_H
+#define __SRC_PARALLEL_COUNTER_H
+
+#include <bagel_config.h>
+#ifdef HAVE_MPI_H
+ #include <mpi.h>
+#endif
+
+namespace bagel {
+
+// Shared task counter for dynamic load balancing. The counter lives on process 0 of the communicator that is current
+// at construction, and next() can be called by any of its processes without synchronization (also after mpi__->split).
+// Construction and destruction are collective.
+class Counter {
+  protected:
+#ifdef HAVE_MPI_H
+    MPI_Win win_;
+    int* win_base_;
+#endif
+    int local_;
+
+  public:
+    Counter();
+    Counter(const Counter&) = delete;
+    ~Counter();
+
+    // returns the current value and increments it atomically
+    int next();
+};
+
+}
+
+#endif
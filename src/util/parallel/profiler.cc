@@ -0,0 +1,210 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: profiler.cc
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <set>
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <src/util/parallel/profiler.h>
+#include <src/util/parallel/mpi_interface.h>
+
+using namespace std;
+using namespace bagel;
+
+bool Profiler::enabled_ = false;
+string Profiler::filename_;
+mutex Profiler::mutex_;
+map<string, Profiler::Region> Profiler::regions_;
+
+namespace {
+  struct Frame {
+    string path;
+    chrono::steady_clock::time_point start;
+    double child;
+    size_t bytes;
+  };
+  // regions open on this thread, and the path under which the outermost of them is recorded
+  thread_local vector<Frame> frames;
+  thread_local string base;
+
+  string join(const string& parent, const string& name) { return parent.empty() ? name : parent + "/" + name; }
+
+  string escape(const string& in) {
+    string out;
+    for (auto& c : in) {
+      if (c == '"' || c == '\\') out += '\\';
+      out += c;
+    }
+    return out;
+  }
+}
+
+
+void Profiler::init() {
+  char const* val = getenv("BAGEL_PROFILE");
+  filename_ = val ? string(val) : "";
+  enabled_ = !filename_.empty();
+}
+
+
+void Profiler::add(const string& path, const double inclusive, const double exclusive, const size_t bytes, const size_t count) {
+  lock_guard<mutex> lock(mutex_);
+  Region& r = regions_[path];
+  r.count += count;
+  r.inclusive += inclusive;
+  r.exclusive += exclusive;
+  r.bytes += bytes;
+}
+
+
+void Profiler::push(const string& name) {
+  frames.push_back({join(current(), name), chrono::steady_clock::now(), 0.0, 0lu});
+}
+
+
+void Profiler::pop() {
+  assert(!frames.empty());
+  const Frame f = frames.back();
+  frames.pop_back();
+  const double inclusive = chrono::duration<double>(chrono::steady_clock::now() - f.start).count();
+  add(f.path, inclusive, inclusive - f.child, f.bytes);
+  if (!frames.empty())
+    frames.back().child += inclusive;
+}
+
+
+string Profiler::current() {
+  return frames.empty() ? base : frames.back().path;
+}
+
+
+string Profiler::set_base(const string& b) {
+  string out = base;
+  base = b;
+  return out;
+}
+
+
+void Profiler::record(const string& name, const double time) {
+  if (!enabled_) return;
+  // Timer intervals may overlap with regions, so they are not subtracted from the exclusive time of the parent
+  add(join(current(), name), time, time, 0lu);
+}
+
+
+void Profiler::allocated(const size_t bytes) {
+  if (!enabled_) return;
+  if (!frames.empty())
+    frames.back().bytes += bytes;
+  else if (!base.empty())
+    // allocated in a worker thread outside of any region; the parent region is open on another thread
+    add(base, 0.0, 0.0, bytes, 0lu);
+}
+
+
+void Profiler::write() {
+  if (!enabled_) return;
+
+  // the union of the region names over the processes, packed as characters
+  string names;
+  {
+    lock_guard<mutex> lock(mutex_);
+    for (auto& i : regions_)
+      names += i.first + '\n';
+  }
+  const int size = mpi__->size();
+  vector<int> lengths(size);
+  const int length = names.size();
+  mpi__->allgather(&length, 1, lengths.data(), 1);
+  const int maxlength = *max_element(lengths.begin(), lengths.end());
+  vector<int> packed(maxlength, 0), allpacked(maxlength*size);
+  copy(names.begin(), names.end(), packed.begin());
+  if (maxlength)
+    mpi__->allgather(packed.data(), maxlength, allpacked.data(), maxlength);
+
+  set<string> all;
+  for (int r = 0; r != size; ++r) {
+    string current;
+    for (int i = 0; i != lengths[r]; ++i) {
+      const char c = static_cast<char>(allpacked[r*maxlength+i]);
+      if (c == '\n') {
+        all.insert(current);
+        current.clear();
+      } else {
+        current += c;
+      }
+    }
+  }
+  if (all.empty()) return;
+
+  // sums over the processes, and the inclusive time of each process
+  const size_t n = all.size();
+  vector<double> sum(4*n, 0.0);
+  vector<double> inclusive(n, 0.0), allinclusive(n*size);
+  {
+    lock_guard<mutex> lock(mutex_);
+    size_t j = 0;
+    for (auto& i : all) {
+      auto iter = regions_.find(i);
+      if (iter != regions_.end()) {
+        sum[4*j  ] = iter->second.count;
+        sum[4*j+1] = iter->second.inclusive;
+        sum[4*j+2] = iter->second.exclusive;
+        sum[4*j+3] = iter->second.bytes;
+        inclusive[j] = iter->second.inclusive;
+      }
+      ++j;
+    }
+  }
+  mpi__->allreduce(sum.data(), sum.size());
+  mpi__->allgather(inclusive.data(), n, allinclusive.data(), n);
+
+  if (mpi__->rank() == 0) {
+    ofstream ofs(filename_);
+    if (!ofs.is_open())
+      throw runtime_error("could not open " + filename_ + " for the profile");
+    ofs << "{" << endl;
+    ofs << "  \"nprocs\": " << size << "," << endl;
+    ofs << "  \"time_unit\": \"s\"," << endl;
+    ofs << "  \"regions\": [" << endl;
+    ofs << setprecision(6) << fixed;
+    size_t j = 0;
+    for (auto& i : all) {
+      double tmin = allinclusive[j], tmax = allinclusive[j];
+      for (int r = 1; r != size; ++r) {
+        tmin = min(tmin, allinclusive[r*n+j]);
+        tmax = max(tmax, allinclusive[r*n+j]);
+      }
+      ofs << "    {\"name\": \"" << escape(i) << "\", \"count\": " << static_cast<size_t>(sum[4*j]) << ", \"inclusive\": " << sum[4*j+1]
+          << ", \"exclusive\": " << sum[4*j+2] << ", \"inclusive_min\": " << tmin << ", \"inclusive_max\": " << tmax
+          << ", \"bytes\": " << static_cast<size_t>(sum[4*j+3]) << "}" << (j+1 != n ? "," : "") << endl;
+      ++j;
+    }
+    ofs << "  ]" << endl;
+    ofs << "}" << endl;
+  }
+}
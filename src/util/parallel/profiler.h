@@ -0,0 +1,103 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: profiler.h
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __SRC_PARALLEL_PROFILER_H
+#define __SRC_PARALLEL_PROFILER_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <chrono>
+
+namespace bagel {
+
+// Registry of named, nested code regions. Regions are opened with the scoped class Profile and are identified by their path
+// (e.g., "rhf/Fock build"). Call counts, inclusive and exclusive times, and bytes allocated directly in the region are
+// accumulated over threads, summed over MPI processes at the end of a run, and written as JSON. Intervals printed by
+// Timer are recorded as well. Everything is a no-op unless the environment variable BAGEL_PROFILE is set to the output file name.
+class Profiler {
+  public:
+    struct Region {
+      size_t count = 0;
+      double inclusive = 0.0;
+      double exclusive = 0.0;
+      size_t bytes = 0;
+    };
+
+  protected:
+    static bool enabled_;
+    static std::string filename_;
+    static std::mutex mutex_;
+    static std::map<std::string, Region> regions_;
+
+    static void add(const std::string& path, const double inclusive, const double exclusive, const size_t bytes, const size_t count = 1);
+
+  public:
+    static void init();
+    static bool enabled() { return enabled_; }
+
+    static void push(const std::string& name);
+    static void pop();
+
+    // path of the innermost region open on this thread; used to nest regions opened in worker threads
+    static std::string current();
+    // returns the previous one
+    static std::string set_base(const std::string& base);
+
+    // records a measured interval as a child region of the current one (used by Timer)
+    static void record(const std::string& name, const double time);
+    // adds to the bytes allocated in the current region
+    static void allocated(const size_t bytes);
+
+    // collective; sums the regions over the processes and writes the summary from rank 0
+    static void write();
+};
+
+
+class Profile {
+  protected:
+    const bool enabled_;
+
+  public:
+    Profile(const std::string& name) : enabled_(Profiler::enabled()) { if (enabled_) Profiler::push(name); }
+    ~Profile() { if (enabled_) Profiler::pop(); }
+};
+
+
+// sets the parent path of the regions opened in a worker thread for the lifetime of this object
+class ProfileBase {
+  protected:
+    const bool enabled_;
+    std::string previous_;
+
+  public:
+    ProfileBase(const std::string& base) : enabled_(Profiler::enabled()) { if (enabled_) previous_ = Profiler::set_base(base); }
+    ~ProfileBase() { if (enabled_) Profiler::set_base(previous_); }
+};
+
+}
+
+#endif
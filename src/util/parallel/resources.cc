@@ -22,12 +22,27 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <iostream>
+#include <iomanip>
 #include <src/util/parallel/resources.h>
+#include <src/util/parallel/profiler.h>
 
 using namespace std;
 using namespace bagel;
 
-StackMem::StackMem() : pointer_(0LU), total_(20000000LU) { // TODO this should not be hardwired
+namespace {
+  // StackMem kept by each thread for reuse without locking; the pool in Resources is used when this is empty or full
+  thread_local vector<shared_ptr<StackMem>> local_stackmem;
+  const size_t max_local_stackmem = 4;
+
+  void update_max(atomic<size_t>& a, const size_t b) {
+    size_t c = a.load();
+    while (c < b && !a.compare_exchange_weak(c, b)) ;
+  }
+}
+
+
+StackMem::StackMem(const size_t size) : pointer_(0LU), total_(size), high_water_(0LU), noverflow_(0LU), max_overflow_(0LU) {
   stack_area_ = unique_ptr<double[]>(new double[total_]);
 
   // in case we use Libint for ERI
@@ -42,30 +57,86 @@ StackMem::StackMem() : pointer_(0LU), total_(20000000LU) { // TODO this should n
 }
 
 
-Resources::Resources(const int max) : proc_(make_shared<Process>()), max_num_threads_(max) {
+double* StackMem::get_overflow(const size_t size) {
+  // the stack area is exhausted; fall back to the heap so that high angular momenta do not corrupt memory
+  overflow_.emplace_back(new double[size]);
+  Profiler::allocated(size*sizeof(double));
+  ++noverflow_;
+  max_overflow_ = max(max_overflow_, size);
+  return overflow_.back().get();
+}
+
+
+void StackMem::release_overflow() {
+  overflow_.pop_back();
+}
+
+
+Resources::Resources(const int max) : proc_(make_shared<Process>()), stack_size_(20000000LU), nstackmem_(0LU), high_water_(0LU), noverflow_(0LU),
+                                      max_overflow_(0LU), max_num_threads_(max), threadpool_(make_shared<ThreadPool>()) {
 #ifdef LIBINT_INTERFACE
   LIBINT2_PREFIXED_NAME(libint2_static_init)();
 #endif
-  for (int i = 0; i != max; ++i)
-    stackmem_[make_shared<StackMem>()].clear();
 }
 
 
 shared_ptr<StackMem> Resources::get() {
-  for (auto& i : stackmem_) {
-    if (!i.second.test_and_set())
-      return i.first;
+  const size_t size = stack_size_;
+  while (!local_stackmem.empty()) {
+    shared_ptr<StackMem> out = local_stackmem.back();
+    local_stackmem.pop_back();
+    if (out->size() == size)
+      return out;
+    --nstackmem_;
+  }
+  {
+    lock_guard<mutex> lock(stackmem_mutex_);
+    while (!stackmem_.empty()) {
+      shared_ptr<StackMem> out = stackmem_.back();
+      stackmem_.pop_back();
+      if (out->size() == size)
+        return out;
+      --nstackmem_;
+    }
   }
-  // This error most often occurs if we forget to destruct one integral object before constructing another
-  throw runtime_error("Stack Memory exhausted");
-  return nullptr;
+  ++nstackmem_;
+  Profiler::allocated(size*sizeof(double));
+  return make_shared<StackMem>(size);
 }
 
 
 void Resources::release(shared_ptr<StackMem> o) {
+  update_max(high_water_, o->high_water());
+  update_max(max_overflow_, o->max_overflow());
+  noverflow_ += o->noverflow();
   o->clear();
-  auto iter = stackmem_.find(o);
-  assert(iter != stackmem_.end());
-  iter->second.clear();
+
+  if (o->size() != stack_size_) {
+    // the stack size has changed while this one was in use
+    --nstackmem_;
+  } else if (local_stackmem.size() < max_local_stackmem) {
+    local_stackmem.push_back(o);
+  } else {
+    lock_guard<mutex> lock(stackmem_mutex_);
+    stackmem_.push_back(o);
+  }
 }
 
+
+void Resources::set_stack_size(const size_t size) {
+  // only grows, so that a smaller geometry set up later does not shrink the arenas of the integral code still in use
+  if (size <= stack_size_) return;
+  stack_size_ = size;
+  // StackMem of the old size are discarded when they are next requested
+  lock_guard<mutex> lock(stackmem_mutex_);
+  nstackmem_ -= stackmem_.size();
+  stackmem_.clear();
+}
+
+
+void Resources::print_stack_usage() const {
+  cout << "  * stack memory: " << nstackmem_ << " arenas of " << setprecision(1) << fixed << stack_size_*sizeof(double)*1.0e-6 << " MB; high-water mark "
+       << high_water_*sizeof(double)*1.0e-6 << " MB" << endl;
+  if (noverflow_)
+    cout << "    " << noverflow_ << " requests overflowed to the heap (largest " << max_overflow_*sizeof(double)*1.0e-6 << " MB)" << endl;
+}
@@ -30,7 +30,9 @@
 #include <stddef.h>
 #include <memory>
 #include <atomic>
+#include <mutex>
 #include <vector>
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 #include <complex>
@@ -39,6 +41,7 @@
   #include <libint2.h>
 #endif
 #include <src/util/parallel/process.h>
+#include <src/util/parallel/threadpool.h>
 #include <src/util/constants.h>
 
 namespace bagel {
@@ -49,31 +52,53 @@ class StackMem {
     size_t pointer_;
     const size_t total_;
 
+    // largest pointer_ since the last clear()
+    size_t high_water_;
+    // heap blocks handed out when the stack area is exhausted; they are released in the LIFO order as well
+    std::vector<std::unique_ptr<double[]>> overflow_;
+    size_t noverflow_;
+    size_t max_overflow_;
+
+    double* get_overflow(const size_t size);
+    void release_overflow();
+
 #ifdef LIBINT_INTERFACE
     std::unique_ptr<Libint_t[]> libint_t_;
 #endif
 
   public:
-    StackMem();
+    StackMem(const size_t size = 20000000LU);
 
     template <typename DataType = double>
     DataType* get(const size_t size) {
-      assert(pointer_ + size < total_);
       assert(size * sizeof(DataType) % sizeof(double) == 0);
+      const size_t dsize = size * sizeof(DataType) / sizeof(double);
+      if (pointer_ + dsize > total_)
+        return reinterpret_cast<DataType*>(get_overflow(dsize));
       DataType* out = reinterpret_cast<DataType*> (stack_area_.get() + pointer_);
-      pointer_ += (size * sizeof(DataType) / sizeof(double));
+      pointer_ += dsize;
+      high_water_ = std::max(high_water_, pointer_);
       return out;
     }
 
     template <typename DataType = double>
     void release(const size_t size, DataType* p) {
       assert(size * sizeof(DataType) % sizeof(double) == 0);
+      if (!overflow_.empty() && reinterpret_cast<double*>(p) == overflow_.back().get()) {
+        release_overflow();
+        return;
+      }
       pointer_ -= (size * sizeof(DataType) / sizeof(double));
       assert(p == reinterpret_cast<DataType*> (stack_area_.get()+pointer_) || size == 0);
     }
 
-    void clear() { pointer_ = 0LU; }
+    void clear() { pointer_ = 0LU; high_water_ = 0LU; overflow_.clear(); noverflow_ = 0LU; max_overflow_ = 0LU; }
     size_t pointer() const { return pointer_; }
+    size_t size() const { return total_; }
+
+    size_t high_water() const { return high_water_; }
+    size_t noverflow() const { return noverflow_; }
+    size_t max_overflow() const { return max_overflow_; }
 
 #ifdef LIBINT_INTERFACE
     Libint_t* libint_t_ptr(const int i) { return &libint_t_[i]; }
@@ -85,8 +110,20 @@ class StackMem {
 class Resources {
   private:
     std::shared_ptr<Process> proc_;
-    std::map<std::shared_ptr<StackMem>, std::atomic_flag> stackmem_;
+
+    // StackMem that are not in use. Each thread keeps a small cache of its own in front of this pool (see resources.cc)
+    std::vector<std::shared_ptr<StackMem>> stackmem_;
+    std::mutex stackmem_mutex_;
+    std::atomic<size_t> stack_size_;
+
+    // usage statistics (in the unit of double)
+    std::atomic<size_t> nstackmem_;
+    std::atomic<size_t> high_water_;
+    std::atomic<size_t> noverflow_;
+    std::atomic<size_t> max_overflow_;
+
     size_t max_num_threads_;
+    std::shared_ptr<ThreadPool> threadpool_;
 
   public:
     Resources(const int max);
@@ -94,8 +131,14 @@ class Resources {
     std::shared_ptr<StackMem> get();
     void release(std::shared_ptr<StackMem> o);
 
+    // size of the StackMem handed out from now on (never decreased); set by Geometry from its largest shell quartet
+    void set_stack_size(const size_t size);
+    size_t stack_size() const { return stack_size_; }
+    void print_stack_usage() const;
+
     size_t max_num_threads() const { return max_num_threads_; }
     std::shared_ptr<Process> proc() { return proc_; }
+    std::shared_ptr<ThreadPool> threadpool() { return threadpool_; }
 };
 
 extern Resources* resources__;
@@ -27,6 +27,7 @@
 #include <src/util/math/algo.h>
 #include <src/util/parallel/rmawindow.h>
 #include <src/util/parallel/mpi_interface.h>
+#include <src/util/parallel/profiler.h>
 
 using namespace std;
 using namespace bagel;
@@ -51,7 +52,7 @@ bool RMATask<DataType>::test() {
 
 
 template<typename DataType>
-RMAWindow<DataType>::RMAWindow() : initialized_(false) {
+RMAWindow<DataType>::RMAWindow() : win_base_(nullptr), initialized_(false) {
 #ifndef HAVE_MPI_H
   throw logic_error("RMAWindow should be used with MPI");
 #endif
@@ -63,7 +64,7 @@ void RMAWindow<DataType>::initialize() {
 #ifdef HAVE_MPI_H
   assert(!initialized_);
   // allocate a window
-  MPI_Win_allocate(localsize()*sizeof(DataType), sizeof(DataType), MPI_INFO_NULL, mpi__->mpi_comm(), &win_base_, &win_);
+  create_window();
   MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
 
   initialized_ = true;
@@ -73,22 +74,53 @@ void RMAWindow<DataType>::initialize() {
 
 
 template<typename DataType>
-RMAWindow<DataType>::~RMAWindow() {
+void RMAWindow<DataType>::create_window() {
+  Profiler::allocated(localsize()*sizeof(DataType));
+#ifdef HAVE_MPI_H
+  MPI_Win_allocate(localsize()*sizeof(DataType), sizeof(DataType), MPI_INFO_NULL, mpi__->mpi_comm(), &win_base_, &win_);
+#endif
+}
+
+
+template<typename DataType>
+void RMAWindow<DataType>::free_window() {
 #ifdef HAVE_MPI_H
   assert(initialized_);
   MPI_Win_unlock_all(win_);
   MPI_Win_free(&win_);
+  initialized_ = false;
+#endif
+}
+
+
+template<typename DataType>
+RMAWindow<DataType>::~RMAWindow() {
+#ifdef HAVE_MPI_H
+  if (initialized_)
+    free_window();
 #endif
 }
 
 
+template<typename DataType>
+void RMAWindow<DataType>::for_each_chunk(const RMAWindow<DataType>* o, function<void(const size_t, const size_t)> f) const {
+  const size_t loc = localsize();
+  const size_t chunk = max(chunk_size(), static_cast<size_t>(1));
+  for (size_t off = 0; off < loc; off += chunk) {
+    const size_t size = min(chunk, loc-off);
+    touch(off, size);
+    if (o)
+      o->touch(off, size);
+    f(off, size);
+  }
+}
+
+
 template<typename DataType>
 void RMAWindow<DataType>::zero() {
   assert(initialized_);
   fence();
-  const size_t loc = localsize();
-  if (loc)
-    fill_n(win_base_, loc, 0.0);
+  for_each_chunk(nullptr, [this](const size_t off, const size_t size) { fill_n(win_base_+off, size, 0.0); });
   fence_local();
   mpi__->barrier();
 }
@@ -98,9 +130,7 @@ template<typename DataType>
 void RMAWindow<DataType>::scale(const DataType& a) {
   assert(initialized_);
   fence();
-  const size_t loc = localsize();
-  if (loc)
-    blas::scale_n(a, win_base_, loc);
+  for_each_chunk(nullptr, [&](const size_t off, const size_t size) { blas::scale_n(a, win_base_+off, size); });
   fence_local();
   mpi__->barrier();
 }
@@ -113,10 +143,8 @@ RMAWindow<DataType>& RMAWindow<DataType>::operator=(const RMAWindow<DataType>& o
     initialize();
   fence();
   o.fence();
-  const size_t loc = localsize();
-  assert(loc == o.localsize());
-  if (loc)
-    copy_n(o.win_base_, loc, win_base_);
+  assert(localsize() == o.localsize());
+  for_each_chunk(&o, [&](const size_t off, const size_t size) { copy_n(o.win_base_+off, size, win_base_+off); });
   fence_local();
   o.fence_local();
   mpi__->barrier();
@@ -131,6 +159,7 @@ void RMAWindow<DataType>::fence() const {
   MPI_Win_flush_all(win_);
   mpi__->barrier();
 #endif
+  after_fence();
 }
 
 
@@ -148,9 +177,7 @@ void RMAWindow<DataType>::ax_plus_y(const DataType& a, const RMAWindow<DataType>
   assert(initialized_);
   fence();
   o.fence();
-  const size_t loc = localsize();
-  if (loc)
-    blas::ax_plus_y_n(a, o.win_base_, loc, win_base_);
+  for_each_chunk(&o, [&](const size_t off, const size_t size) { blas::ax_plus_y_n(a, o.win_base_+off, size, win_base_+off); });
   fence_local();
   o.fence_local();
   mpi__->barrier();
@@ -162,8 +189,8 @@ DataType RMAWindow<DataType>::dot_product(const RMAWindow<DataType>& o) const {
   assert(initialized_);
   fence();
   o.fence();
-  const size_t loc = localsize();
-  DataType out = loc ? blas::dot_product(win_base_, loc, o.win_base_) : 0.0;
+  DataType out = 0.0;
+  for_each_chunk(&o, [&](const size_t off, const size_t size) { out += blas::dot_product(win_base_+off, size, o.win_base_+off); });
   fence_local();
   o.fence_local();
   mpi__->allreduce(&out, 1);
@@ -194,6 +221,8 @@ void RMAWindow<DataType>::rma_get(DataType* data, const size_t key) const {
   assert(initialized_);
   size_t rank, off, size;
   tie(rank, off, size) = locate(key);
+  if (rank == mpi__->rank())
+    touch(off, size);
   rma_get(data, rank, off, size);
 }
 
@@ -215,6 +244,8 @@ void RMAWindow<DataType>::rma_put(const DataType* dat, const size_t key) {
   assert(initialized_);
   size_t rank, off, size;
   tie(rank, off, size) = locate(key);
+  if (rank == mpi__->rank())
+    touch(off, size);
   rma_put(dat, rank, off, size);
 }
 
@@ -236,6 +267,8 @@ void RMAWindow<DataType>::rma_add(const unique_ptr<DataType[]>& dat, const size_
   assert(initialized_);
   size_t rank, off, size;
   tie(rank, off, size) = locate(key);
+  if (rank == mpi__->rank())
+    touch(off, size);
   rma_add(dat, rank, off, size);
 }
 
@@ -256,6 +289,8 @@ template<typename DataType>
 shared_ptr<RMATask<DataType>> RMAWindow<DataType>::rma_rget(DataType* buf, const size_t key) const {
   size_t rank, off, size;
   tie(rank, off, size) = locate(key);
+  if (rank == mpi__->rank())
+    touch(off, size);
   return rma_rget(buf, rank, off, size);
 }
 
@@ -277,6 +312,8 @@ template<typename DataType>
 shared_ptr<RMATask<DataType>> RMAWindow<DataType>::rma_radd(unique_ptr<DataType[]>&& buf, const size_t key) {
   size_t rank, off, size;
   tie(rank, off, size) = locate(key);
+  if (rank == mpi__->rank())
+    touch(off, size);
   return rma_radd(move(buf), rank, off, size);
 }
 
@@ -334,7 +371,7 @@ void RMAWindow<DataType>::set_element(const size_t rank, const size_t disp, cons
 template<typename DataType>
 void RMAWindow<DataType>::accumulate_buffer(const DataType a, const unique_ptr<DataType[]>& buf) {
   fence();
-  blas::ax_plus_y_n(a, buf.get(), localsize(), win_base_);
+  for_each_chunk(nullptr, [&](const size_t off, const size_t size) { blas::ax_plus_y_n(a, buf.get()+off, size, win_base_+off); });
   fence_local();
   mpi__->barrier();
 }
@@ -28,6 +28,7 @@
 #include <bagel_config.h>
 #include <complex>
 #include <memory>
+#include <functional>
 #ifdef HAVE_MPI_H
  #include <mpi.h>
 #endif
@@ -64,6 +65,20 @@ class RMAWindow {
 
     bool initialized_;
 
+    // allocates win_ and win_base_ (collective). Can be overridden to attach other kinds of memory to the window
+    virtual void create_window();
+    // frees the window (collective)
+    void free_window();
+    // called before the local region [off, off+size) is accessed
+    virtual void touch(const size_t off, const size_t size) const { }
+    // whole-window operations visit the local memory in chunks of this many elements
+    virtual size_t chunk_size() const { return localsize(); }
+    // called at the end of fence(), when all the preceding RMA operations have completed
+    virtual void after_fence() const { }
+
+    // calls f(off, size) for each chunk of the local memory after touching the chunk of this (and o)
+    void for_each_chunk(const RMAWindow<DataType>* o, std::function<void(const size_t, const size_t)> f) const;
+
   public:
     RMAWindow();
     virtual ~RMAWindow();
@@ -0,0 +1,104 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: threadpool.cc
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <cassert>
+#include <src/util/parallel/threadpool.h>
+
+using namespace std;
+using namespace bagel;
+
+namespace {
+  thread_local bool in_worker_ = false;
+}
+
+
+ThreadPool::~ThreadPool() {
+  {
+    lock_guard<mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (auto& i : threads_)
+    i.join();
+}
+
+
+bool ThreadPool::in_worker() {
+  return in_worker_;
+}
+
+
+void ThreadPool::worker(const int id) {
+  in_worker_ = true;
+  size_t generation = 0;
+  while (true) {
+    function<void(int)> job;
+    {
+      unique_lock<mutex> lock(mutex_);
+      start_.wait(lock, [&]() { return stop_ || (generation_ != generation && id < njob_); });
+      if (stop_) return;
+      generation = generation_;
+      job = job_;
+    }
+    job(id);
+    {
+      lock_guard<mutex> lock(mutex_);
+      if (--remaining_ == 0)
+        finish_.notify_one();
+    }
+  }
+}
+
+
+void ThreadPool::run(const int n, const function<void(int)>& f) {
+  // nested calls, or calls while another thread is using the pool, are processed by the calling thread alone
+  unique_lock<mutex> runlock(run_mutex_, defer_lock);
+  if (n <= 1 || in_worker_ || !runlock.try_lock()) {
+    for (int i = 0; i < n; ++i)
+      f(i);
+    return;
+  }
+
+  // worker i runs f(i); f(0) is run by this thread
+  for (int i = threads_.size()+1; i < n; ++i)
+    threads_.emplace_back(&ThreadPool::worker, this, i);
+
+  {
+    lock_guard<mutex> lock(mutex_);
+    job_ = f;
+    njob_ = n;
+    remaining_ = n-1;
+    ++generation_;
+  }
+  start_.notify_all();
+
+  in_worker_ = true;
+  f(0);
+  in_worker_ = false;
+
+  unique_lock<mutex> lock(mutex_);
+  finish_.wait(lock, [this]() { return remaining_ == 0; });
+  job_ = nullptr;
+}
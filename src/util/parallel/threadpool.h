@@ -0,0 +1,71 @@
+//
+// BAGEL - Brilliantly Advanced General Electronic Structure Library
+// Filename: threadpool.h
+// Copyright (C) 2018 Toru Shiozaki
+//
+// Author: Shiozaki group <shiozaki@northwestern.edu>
+// Maintainer: Shiozaki group
+//
+// This file is part of the BAGEL package.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __SRC_PARALLEL_THREADPOOL_H
+#define __SRC_PARALLEL_THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace bagel {
+
+// Persistent pool of worker threads. run(n, f) calls f(0), ..., f(n-1) concurrently, where f(0) is
+// executed by the calling thread, and returns when all of them have finished. Threads are created
+// on first use and are reused afterwards.
+class ThreadPool {
+  protected:
+    std::vector<std::thread> threads_;
+
+    // serializes the callers of run
+    std::mutex run_mutex_;
+
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable finish_;
+
+    std::function<void(int)> job_;
+    int njob_;
+    int remaining_;
+    size_t generation_;
+    bool stop_;
+
+    void worker(const int id);
+
+  public:
+    ThreadPool() : njob_(0), remaining_(0), generation_(0), stop_(false) { }
+    ~ThreadPool();
+
+    void run(const int n, const std::function<void(int)>& f);
+
+    // true if called from within a job of this pool
+    static bool in_worker();
+};
+
+}
+
+#endif
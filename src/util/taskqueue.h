@@ -28,22 +28,34 @@
 
 #include <stddef.h>
 #include <list>
+#include <deque>
+#include <mutex>
 #include <atomic>
+#include <thread>
+#include <chrono>
 #include <memory>
 #include <stdexcept>
 #include <utility>
-#include <thread>
 #include <algorithm>
+#include <functional>
+#include <queue>
 
 #include <vector>
 #include <bagel_config.h>
 #ifdef HAVE_MKL_H
   #include "mkl_service.h"
 #endif
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
 #include <src/util/parallel/resources.h>
+#include <src/util/parallel/profiler.h>
 
 namespace bagel {
 
+// Tasks are dealt to per-thread deques before the threads start. Each thread takes tasks from the front of its own
+// deque and, when it runs dry, steals the back half of another thread's deque. If the task type has a member
+// function cost(), tasks are dealt in the order of decreasing cost so that expensive tasks do not end up at the tail.
 template<typename T>
 class TaskQueue {
 
@@ -65,11 +77,96 @@ class TaskQueue {
     template<typename U> void call_compute(U& task)                  { call<U, has_compute<U>::value>::compute(task); }
     template<typename U> void call_compute(std::shared_ptr<U>& task) { call<U, has_compute<U>::value>::compute(*task); }
 
+    template <class U>
+    struct has_cost {
+      protected:
+        template<class V> static auto __cost(V* p) -> decltype(p->cost(), std::true_type());
+        template<class  > static std::false_type __cost(...);
+      public:
+        static constexpr const bool value = std::is_same<std::true_type, decltype(__cost<U>(0))>::value;
+    };
+    template<typename U, bool>
+    struct cost       { static double get(const U& task) { return 0.0; } };
+    template<typename U>
+    struct cost<U, true> { static double get(const U& task) { return task.cost(); } };
+    template<typename U> static constexpr bool hinted(const U*)                  { return has_cost<U>::value; }
+    template<typename U> static constexpr bool hinted(const std::shared_ptr<U>*) { return has_cost<U>::value; }
+    template<typename U> double call_cost(const U& task) const                  { return cost<U, has_cost<U>::value>::get(task); }
+    template<typename U> double call_cost(const std::shared_ptr<U>& task) const { return cost<U, has_cost<U>::value>::get(*task); }
+
+    struct Deque {
+      std::mutex mutex;
+      std::deque<size_t> task;
+    };
+
   protected:
     std::vector<T> task_;
-    std::list<std::atomic_flag> flag_;
+    std::vector<std::unique_ptr<Deque>> deque_;
+    std::vector<std::chrono::steady_clock::time_point> finish_;
     static const int chunck_ = 12;
 
+    // statistics of the last call to compute (in seconds)
+    double wall_ = 0.0;
+    double idle_ = 0.0;
+
+    void deal(const int n) {
+      deque_.resize(n);
+      for (auto& i : deque_)
+        if (!i) i.reset(new Deque());
+        else i->task.clear();
+
+      if (hinted(static_cast<const T*>(nullptr))) {
+        // longest processing time first: the most expensive remaining task goes to the least loaded thread
+        std::vector<std::pair<double,size_t>> costs(task_.size());
+        for (size_t i = 0; i != task_.size(); ++i)
+          costs[i] = std::make_pair(call_cost(task_[i]), i);
+        std::stable_sort(costs.begin(), costs.end(), [](const std::pair<double,size_t>& a, const std::pair<double,size_t>& b) { return a.first > b.first; });
+        using Load = std::pair<double,int>;
+        std::priority_queue<Load, std::vector<Load>, std::greater<Load>> load;
+        for (int i = 0; i != n; ++i)
+          load.emplace(0.0, i);
+        for (auto& i : costs) {
+          Load l = load.top();
+          load.pop();
+          deque_[l.second]->task.push_back(i.second);
+          load.emplace(l.first + i.first, l.second);
+        }
+      } else {
+        // contiguous chunks in a round-robin fashion
+        for (size_t i = 0; i < task_.size(); ++i)
+          deque_[(i/chunck_) % n]->task.push_back(i);
+      }
+    }
+
+    bool pop(const int id, size_t& out) {
+      std::lock_guard<std::mutex> lock(deque_[id]->mutex);
+      if (deque_[id]->task.empty())
+        return false;
+      out = deque_[id]->task.front();
+      deque_[id]->task.pop_front();
+      return true;
+    }
+
+    bool steal(const int id) {
+      const int n = deque_.size();
+      for (int k = 1; k < n; ++k) {
+        Deque& victim = *deque_[(id+k)%n];
+        std::vector<size_t> stolen;
+        {
+          std::lock_guard<std::mutex> lock(victim.mutex);
+          const size_t nsteal = (victim.task.size()+1)/2;
+          stolen.assign(victim.task.end()-nsteal, victim.task.end());
+          victim.task.erase(victim.task.end()-nsteal, victim.task.end());
+        }
+        if (!stolen.empty()) {
+          std::lock_guard<std::mutex> lock(deque_[id]->mutex);
+          deque_[id]->task.insert(deque_[id]->task.end(), stolen.begin(), stolen.end());
+          return true;
+        }
+      }
+      return false;
+    }
+
   public:
     TaskQueue(size_t expected = 0) { task_.reserve(expected); }
     TaskQueue(std::vector<T>&& t) : task_(std::move(t)) { }
@@ -83,33 +180,54 @@ class TaskQueue {
       const int mkl_num = mkl_get_max_threads();
       mkl_set_num_threads(1);
 #endif
+      const int n = std::max(1, static_cast<int>(std::min(static_cast<size_t>(num_threads), task_.size())));
+
+      // regions opened in the tasks are recorded under the region of the caller
+      const std::string region = Profiler::enabled() ? Profiler::current() : "";
+      const auto start = std::chrono::steady_clock::now();
 #ifndef _OPENMP
-      flag_.resize((task_.size()-1)/chunck_+1);
-      std::for_each(flag_.begin(), flag_.end(), [](std::atomic_flag& i){ i.clear(); });
-      std::list<std::thread> threads;
-      for (int i = 0; i != num_threads; ++i)
-        threads.emplace_back(&TaskQueue<T>::compute_one_thread, this);
-      std::for_each(threads.begin(), threads.end(), [](std::thread& i){ i.join(); });
+      deal(n);
+      finish_.resize(n);
+      resources__->threadpool()->run(n, [this, &region](const int id) { ProfileBase base(region); compute_one_thread(id); });
 #else
-      const size_t n = task_.size();
-      #pragma omp parallel for schedule(dynamic,chunck_)
-      for (size_t i = 0; i < n; ++i)
-        call_compute(task_[i]);
+      // the runtime may provide fewer threads than requested; tasks and statistics follow the actual team size
+      #pragma omp parallel num_threads(n)
+      {
+        #pragma omp single
+        {
+          deal(omp_get_num_threads());
+          finish_.resize(omp_get_num_threads());
+        }
+        ProfileBase base(region);
+        compute_one_thread(omp_get_thread_num());
+      }
 #endif
+      const auto end = std::chrono::steady_clock::now();
+
+      wall_ = std::chrono::duration<double>(end - start).count();
+      idle_ = 0.0;
+      for (auto& i : finish_)
+        idle_ += std::chrono::duration<double>(end - i).count();
 #ifdef HAVE_MKL_H
       mkl_set_num_threads(mkl_num);
 #endif
     }
 
-    void compute_one_thread() {
-      int j = 0;
-      for (auto i = flag_.begin(); i != flag_.end(); ++i, j += chunck_)
-        if (!i->test_and_set()) {
-          call_compute(task_[j]);
-          for (int k = 1; k < chunck_; ++k)
-            if (j+k < task_.size()) call_compute(task_[j+k]);
-        }
+    void compute_one_thread(const int id) {
+      size_t i;
+      do {
+        while (pop(id, i))
+          call_compute(task_[i]);
+      } while (steal(id));
+      finish_[id] = std::chrono::steady_clock::now();
     }
+
+    // wall time of the last call to compute
+    double wall_time() const { return wall_; }
+    // time that the threads spent waiting for the others to finish, summed over the threads, in the last call to compute
+    double idle_time() const { return idle_; }
+    // fraction of the thread time that was idle in the last call to compute
+    double idle_fraction() const { return wall_ > 0.0 ? idle_ / (wall_ * finish_.size()) : 0.0; }
 };
 
 }
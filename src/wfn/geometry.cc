@@ -25,6 +25,7 @@
 
 #include <src/wfn/geometry.h>
 #include <src/df/complexdf.h>
+#include <src/df/dfcache.h>
 #include <src/integral/rys/eribatch.h>
 #include <src/integral/rys/smalleribatch.h>
 #include <src/integral/rys/mixederibatch.h>
@@ -49,6 +50,9 @@ Geometry::Geometry(shared_ptr<const PTree> geominfo) : magnetism_(false), do_per
 
   schwarz_thresh_ = geominfo->get<double>("schwarz_thresh", 1.0e-12);
   overlap_thresh_ = geominfo->get<double>("thresh_overlap", 1.0e-8);
+  df_cache_ = geominfo->get<string>("df_cache", "");
+  df_sparse_ = geominfo->get<bool>("df_sparse", false);
+  df_single_ = geominfo->get<bool>("df_single", false);
 
   // skip self interaction between the charges.
   skip_self_interaction_ = geominfo->get<bool>("skip_self_interaction", true);
@@ -151,13 +155,18 @@ Geometry::Geometry(shared_ptr<const PTree> geominfo) : magnetism_(false), do_per
 
 void Geometry::common_init2(const bool print, const double thresh, const bool nodf) {
 
+  // integral batches take their scratch from StackMem; size it for the largest shell quartet in this geometry.
+  // Complex batches (London orbitals or a magnetic field) take twice as many doubles.
+  resources__->set_stack_size(stack_size() * (london_ || nonzero_magnetic_field() ? 2 : 1));
+
   if (london_ || nonzero_magnetic_field()) init_magnetism();
 
   if (!auxfile_.empty() && !nodf && !do_periodic_df_ && !fmm_) {
     if (print) cout << "  Number of auxiliary basis functions: " << setw(8) << naux() << endl << endl;
     cout << "  Since a DF basis is specified, we compute 2- and 3-index integrals:" << endl;
-    const double scale = magnetism_ ? 2.0 : 1.0;
-    cout << "    o Being stored without compression. Storage requirement is "
+    const double scale = magnetism_ ? 2.0 : (df_single_ && !df_sparse_ ? 0.5 : 1.0);
+    cout << (magnetism_ || !df_single_ || df_sparse_ ? "    o Being stored without compression. Storage requirement is "
+                                                      : "    o Being stored in single precision. Storage requirement is ")
          << setprecision(3) << static_cast<size_t>(naux_)*nbasis()*nbasis()*scale*8.e-9 << " GB" << endl;
     Timer timer;
     compute_integrals(thresh);
@@ -177,7 +186,7 @@ void Geometry::common_init2(const bool print, const double thresh, const bool no
 
 // suitable for geometry updates in optimization
 Geometry::Geometry(const Geometry& o, shared_ptr<const Matrix> displ, shared_ptr<const PTree> geominfo, const bool rotate, const bool nodf)
-  : Molecule(o, displ, rotate), schwarz_thresh_(o.schwarz_thresh_), magnetism_(false), london_(o.london_), use_finite_(o.use_finite_), do_periodic_df_(o.do_periodic_df_), hcoreinfo_(o.hcoreinfo_), fmm_(o.fmm_) {
+  : Molecule(o, displ, rotate), schwarz_thresh_(o.schwarz_thresh_), df_cache_(o.df_cache_), df_sparse_(o.df_sparse_), df_single_(o.df_single_), magnetism_(false), london_(o.london_), use_finite_(o.use_finite_), do_periodic_df_(o.do_periodic_df_), hcoreinfo_(o.hcoreinfo_), fmm_(o.fmm_) {
 
   overlap_thresh_ = geominfo->get<double>("thresh_overlap", 1.0e-8);
   set_london(geominfo);
@@ -188,7 +197,7 @@ Geometry::Geometry(const Geometry& o, shared_ptr<const Matrix> displ, shared_ptr
 
 
 Geometry::Geometry(const Geometry& o, const array<double,3> displ)
-  : schwarz_thresh_(o.schwarz_thresh_), overlap_thresh_(o.overlap_thresh_),  magnetism_(false),
+  : schwarz_thresh_(o.schwarz_thresh_), overlap_thresh_(o.overlap_thresh_), df_cache_(o.df_cache_), df_sparse_(o.df_sparse_), df_single_(o.df_single_),  magnetism_(false),
     london_(o.london_), use_finite_(o.use_finite_), do_periodic_df_(o.do_periodic_df_), hcoreinfo_(o.hcoreinfo_), fmm_(o.fmm_) {
 
   // members of Molecule
@@ -218,7 +227,7 @@ Geometry::Geometry(const Geometry& o, const array<double,3> displ)
 
 // used when a new Geometry block is provided in input
 Geometry::Geometry(const Geometry& o, shared_ptr<const PTree> geominfo, const bool discard)
-  : schwarz_thresh_(o.schwarz_thresh_), overlap_thresh_(o.overlap_thresh_), magnetism_(false),
+  : schwarz_thresh_(o.schwarz_thresh_), overlap_thresh_(o.overlap_thresh_), df_cache_(o.df_cache_), df_sparse_(o.df_sparse_), df_single_(o.df_single_), magnetism_(false),
     london_(o.london_), use_finite_(o.use_finite_), do_periodic_df_(o.do_periodic_df_), hcoreinfo_(o.hcoreinfo_), fmm_(o.fmm_) {
 
   // members of Molecule
@@ -234,6 +243,9 @@ Geometry::Geometry(const Geometry& o, shared_ptr<const PTree> geominfo, const bo
   // check all the options
   schwarz_thresh_ = geominfo->get<double>("schwarz_thresh", schwarz_thresh_);
   overlap_thresh_ = geominfo->get<double>("thresh_overlap", overlap_thresh_);
+  df_cache_ = geominfo->get<string>("df_cache", df_cache_);
+  df_sparse_ = geominfo->get<bool>("df_sparse", df_sparse_);
+  df_single_ = geominfo->get<bool>("df_single", df_single_);
 
   spherical_ = !geominfo->get<bool>("cartesian", !spherical_);
 
@@ -312,7 +324,7 @@ Geometry::Geometry(const Geometry& o, shared_ptr<const PTree> geominfo, const bo
 *  supergeometry                                            *
 ************************************************************/
 Geometry::Geometry(vector<shared_ptr<const Geometry>> nmer, const bool nodf) :
-  schwarz_thresh_(nmer.front()->schwarz_thresh_), overlap_thresh_(nmer.front()->overlap_thresh_), magnetism_(false), london_(nmer.front()->london_),
+  schwarz_thresh_(nmer.front()->schwarz_thresh_), overlap_thresh_(nmer.front()->overlap_thresh_), df_cache_(nmer.front()->df_cache_), df_sparse_(nmer.front()->df_sparse_), df_single_(nmer.front()->df_single_), magnetism_(false), london_(nmer.front()->london_),
   use_finite_(nmer.front()->use_finite_), do_periodic_df_(false), hcoreinfo_(nmer.front()->hcoreinfo()), fmm_(nmer.front()->fmm()) {
 
   // A member of Molecule
@@ -389,6 +401,9 @@ Geometry::Geometry(const vector<shared_ptr<const Atom>> atoms, shared_ptr<const
 
   schwarz_thresh_ = geominfo->get<double>("schwarz_thresh", 1.0e-12);
   overlap_thresh_ = geominfo->get<double>("thresh_overlap", 1.0e-8);
+  df_cache_ = geominfo->get<string>("df_cache", "");
+  df_sparse_ = geominfo->get<bool>("df_sparse", false);
+  df_single_ = geominfo->get<bool>("df_single", false);
   skip_self_interaction_ = geominfo->get<bool>("skip_self_interaction", true);
 
   // cartesian or not. Look in the atoms info to find out
@@ -597,15 +612,64 @@ void Geometry::set_london(shared_ptr<const PTree>& geominfo) {
 
 
 void Geometry::compute_integrals(const double thresh) const {
+#ifdef LIBINT_INTERFACE
+  const string tag = "libint";
+  if (!magnetism_ && df_sparse_)
+    cout << "    * df_sparse is ignored with the Libint interface; the 3-index integrals are stored dense" << endl;
+#else
+  const string tag = "eribatch";
+#endif
+#ifndef LIBINT_INTERFACE
+  // only significant shell pairs are stored (the cache is not used in this case)
+  if (!magnetism_ && df_sparse_) {
+    df_ = make_shared<DFDist_ints<ERIBatch>>(nbasis(), naux(), atoms(), aux_atoms(), thresh, true, 0.0, false, nullptr, false, schwarz_thresh_);
+    return;
+  }
+#endif
+  shared_ptr<const DFCache> cache;
+  if (!magnetism_ && !df_cache_.empty()) {
+    cache = make_shared<const DFCache>(df_cache_, nbasis(), naux(), atoms(), aux_atoms(), thresh, tag);
+    df_ = cache->load();
+    if (df_) {
+      cout << "    o Read from the cache in " << df_cache_ << " (key " << cache->key() << ")" << endl;
+      if (df_single_)
+        df_->convert_to_single();
+      return;
+    }
+  }
+
+  // the single-precision integrals are generated batchwise unless the cache needs the double-precision ones
+  const bool single = !magnetism_ && df_single_ && !cache;
 #ifdef LIBINT_INTERFACE
   if (!magnetism_)
-    df_ = form_fit<DFDist_ints<Libint>>(thresh, true); // true means we construct J^-1/2
+    df_ = make_shared<DFDist_ints<Libint>>(nbasis(), naux(), atoms(), aux_atoms(), thresh, true, 0.0, false, nullptr, false, 0.0, single); // true means we construct J^-1/2
 #else
   if (!magnetism_)
-    df_ = form_fit<DFDist_ints<ERIBatch>>(thresh, true); // true means we construct J^-1/2
+    df_ = make_shared<DFDist_ints<ERIBatch>>(nbasis(), naux(), atoms(), aux_atoms(), thresh, true, 0.0, false, nullptr, false, 0.0, single); // true means we construct J^-1/2
 #endif
   else
     df_ = form_fit<ComplexDFDist_ints<ComplexERIBatch>>(thresh, true); // true means we construct J^-1/2
+
+  if (cache)
+    cache->save(df_);
+
+  if (!magnetism_ && df_single_ && !df_->single())
+    df_->convert_to_single();
+}
+
+
+void Geometry::require_dense_df(const string& method) const {
+  if (df_ && !df_->dense())
+    throw runtime_error(method + " requires dense double-precision DF integrals; set \"df_sparse\" and \"df_single\" to false in the molecule block");
+}
+
+
+shared_ptr<DFDist> Geometry::form_df_double() const {
+#ifdef LIBINT_INTERFACE
+  return form_fit<DFDist_ints<Libint>>(overlap_thresh_, true);
+#else
+  return form_fit<DFDist_ints<ERIBatch>>(overlap_thresh_, true);
+#endif
 }
 
 
@@ -634,7 +698,7 @@ void Geometry::init_magnetism() {
 
 
 Geometry::Geometry(const Geometry& o, const string type)
-  : schwarz_thresh_(o.schwarz_thresh_), overlap_thresh_(o.overlap_thresh_), magnetism_(false),
+  : schwarz_thresh_(o.schwarz_thresh_), overlap_thresh_(o.overlap_thresh_), df_cache_(o.df_cache_), df_sparse_(o.df_sparse_), df_single_(o.df_single_), magnetism_(false),
     london_(o.london_), use_finite_(o.use_finite_), do_periodic_df_(o.do_periodic_df_), hcoreinfo_(o.hcoreinfo_) {
 
   if (!o.fmm_)
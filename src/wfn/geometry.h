@@ -40,6 +40,13 @@ class Geometry : public Molecule {
     double schwarz_thresh_;
     double overlap_thresh_;
 
+    // directory in which the 3-index integrals are cached (empty if not used)
+    std::string df_cache_;
+    // if true, only significant shell pairs of the 3-index integrals are stored
+    bool df_sparse_;
+    // if true, the 3-index integrals are stored in single precision
+    bool df_single_;
+
     // for DF calculations
     mutable std::shared_ptr<DFDist> df_;
     // small component
@@ -76,7 +83,7 @@ class Geometry : public Molecule {
     template<class Archive>
     void save(Archive& ar, const unsigned int) const {
       ar << boost::serialization::base_object<Molecule>(*this);
-      ar << schwarz_thresh_ << overlap_thresh_ << magnetism_ << london_ << use_finite_ << do_periodic_df_ << hcoreinfo_ << fmm_;
+      ar << schwarz_thresh_ << overlap_thresh_ << df_cache_ << df_sparse_ << df_single_ << magnetism_ << london_ << use_finite_ << do_periodic_df_ << hcoreinfo_ << fmm_;
       const size_t dfindex = !df_ ? 0 : std::hash<DFDist*>()(df_.get());
       ar << dfindex;
       const bool do_rel   = !!dfs_;
@@ -87,7 +94,7 @@ class Geometry : public Molecule {
     template<class Archive>
     void load(Archive& ar, const unsigned int) {
       ar >> boost::serialization::base_object<Molecule>(*this);
-      ar >> schwarz_thresh_ >> overlap_thresh_ >> magnetism_ >> london_ >> use_finite_ >> do_periodic_df_ >> hcoreinfo_ >> fmm_;
+      ar >> schwarz_thresh_ >> overlap_thresh_ >> df_cache_ >> df_sparse_ >> df_single_ >> magnetism_ >> london_ >> use_finite_ >> do_periodic_df_ >> hcoreinfo_ >> fmm_;
       size_t dfindex;
       ar >> dfindex;
       static std::map<size_t, std::weak_ptr<DFDist>> dfmap;
@@ -127,6 +134,9 @@ class Geometry : public Molecule {
     // Thresholds
     double schwarz_thresh() const { return schwarz_thresh_; }
     double overlap_thresh() const { return overlap_thresh_; }
+    const std::string& df_cache() const { return df_cache_; }
+    bool df_sparse() const { return df_sparse_; }
+    bool df_single() const { return df_single_; }
     bool london() const { return london_; }
     bool magnetism() const { return magnetism_; }
 
@@ -135,16 +145,21 @@ class Geometry : public Molecule {
 
     // Returns DF data
     std::shared_ptr<const DFDist> df() const { return df_; }
+    // throws unless the 3-index integrals are dense and in double precision; used by the methods that access them block by block
+    void require_dense_df(const std::string& method) const;
     std::shared_ptr<const DFDist> dfs() const { return dfs_; }
     std::shared_ptr<const DFDist> dfsl() const { return dfsl_; }
 
     // TODO resolve "mutable" issues
     void discard_df() const { df_.reset(); dfs_.reset(); dfsl_.reset(); }
 
+    // DF integrals in double precision irrespective of df_single_ (used to validate single-precision runs)
+    std::shared_ptr<DFDist> form_df_double() const;
+
     // type T should be a derived class of DFDist
     template<typename T>
-    std::shared_ptr<T> form_fit(const double thr, const bool inverse, const double gam = 0.0, const bool average = false, const std::shared_ptr<Matrix> d2 = nullptr) const {
-      return std::make_shared<T>(nbasis(), naux(), atoms(), aux_atoms(), thr, inverse, gam, average, d2);
+    std::shared_ptr<T> form_fit(const double thr, const bool inverse, const double omega = 0.0, const bool average = false, const std::shared_ptr<Matrix> d2 = nullptr) const {
+      return std::make_shared<T>(nbasis(), naux(), atoms(), aux_atoms(), thr, inverse, omega, average, d2);
     }
 
     // initialize relativistic components